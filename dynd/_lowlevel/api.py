@@ -502,7 +502,9 @@ arrfunc_from_ufunc.__doc__ = """
         ``_lowlevel.numpy_typetuples_from_ufunc``.
     ckernel_acquires_gil : bool
         If True, the resulting ckernel acquires the GIL before calling
-        the ufunc's kernel. If False, it does not.
+        the ufunc's kernel. If False, it does not, and it releases
+        the GIL during long strided calls unless the kernel works
+        with Python objects.
 
     Returns
     -------
@@ -128,7 +128,7 @@ cdef extern from "array_functions.hpp" namespace "pydynd":
     ndarray array_cast(ndarray&, ndt_type&) except +translate_exception
     ndarray array_ucast(ndarray&, ndt_type&, size_t) except +translate_exception
     object array_adapt(object, object, object) except +translate_exception
-    object array_as_py(ndarray&, bint) except +translate_exception
+    object array_as_py(ndarray&, bint, bint) except +translate_exception
     object array_as_numpy(object, bint) except +translate_exception
     ndarray array_from_py(object) except +translate_exception
 
@@ -140,4 +140,23 @@ cdef extern from "array_functions.hpp" namespace "pydynd":
     ndarray dynd_parse_json_type(ndt_type&, ndarray&, object) except +translate_exception
     void dynd_parse_json_array(ndarray&, ndarray&, object) except +translate_exception
 
-    object wrap_array(const ndarray &af)
\ No newline at end of file
+    object wrap_array(const ndarray &af)
+
+cdef extern from "array_pickle.hpp" namespace "pydynd":
+    object array_pickle_state(object, int) except +translate_exception
+    ndarray array_from_pickle_state(object, object, object) except +translate_exception
+
+cdef extern from "shared_memory_array.hpp" namespace "pydynd":
+    ndarray array_shared_empty(ndt_type&, object) except +translate_exception
+    ndarray array_from_shared(object, object) except +translate_exception
+    object array_shared_name(ndarray&) except +translate_exception
+    void dynd_shared_unlink "pydynd::shared_unlink" (object) except +translate_exception
+
+cdef extern from "factorize.hpp" namespace "pydynd":
+    ndarray array_factorize(ndarray&, bint) except +translate_exception
+
+cdef extern from "array_from_py_dynamic.hpp" namespace "pydynd":
+    object array_from_py_dynamic_stats(bint) except +translate_exception
+
+cdef extern from "simd_arithmetic.hpp" namespace "pydynd":
+    const char *get_simd_level_name()
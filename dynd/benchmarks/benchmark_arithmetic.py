@@ -15,20 +15,25 @@ class ArithmeticBenchmark(Benchmark):
   parameters = ('size',)
   size = size
 
-  def __init__(self, op, cuda = False):
+  def __init__(self, op, dtype = 'float64', cuda = False):
     Benchmark.__init__(self)
     self.op = op
+    self.dtype = dtype
     self.cuda = cuda
 
   @median
   def run(self, size):
     if self.cuda:
-      dst_tp = ndt.type('cuda_device[{} * float64]'.format(size))
+      dst_tp = ndt.type('cuda_device[{} * {}]'.format(size, self.dtype))
     else:
-      dst_tp = ndt.type('{} * float64'.format(size))
+      dst_tp = ndt.type('{} * {}'.format(size, self.dtype))
 
-    a = nd.uniform(dst_tp = dst_tp)
-    b = nd.uniform(dst_tp = dst_tp)
+    if self.dtype.startswith('int'):
+      a = nd.range(1, size + 1, dtype = dst_tp.dtype)
+      b = nd.range(1, size + 1, dtype = dst_tp.dtype)
+    else:
+      a = nd.uniform(dst_tp = dst_tp)
+      b = nd.uniform(dst_tp = dst_tp)
 
     with CUDATimer() if self.cuda else Timer() as timer:
       self.op(a, b)
@@ -39,16 +44,17 @@ class NumPyArithmeticBenchmark(Benchmark):
   parameters = ('size',)
   size = size
 
-  def __init__(self, op):
+  def __init__(self, op, dtype = 'float64'):
     Benchmark.__init__(self)
     self.op = op
+    self.dtype = dtype
 
   @median
   def run(self, size):
     import numpy as np
 
-    a = np.random.uniform(size = size)
-    b = np.random.uniform(size = size)
+    a = np.random.uniform(1, 100, size = size).astype(self.dtype)
+    b = np.random.uniform(1, 100, size = size).astype(self.dtype)
 
     with Timer() as timer:
       self.op(a, b)
@@ -79,11 +85,12 @@ class PyCUDAArithmeticBenchmark(Benchmark):
 if __name__ == '__main__':
   cuda = True
 
-  benchmark = ArithmeticBenchmark(add, cuda = False)
-  benchmark.plot_result(loglog = True)
+  for dtype in ['int32', 'int64', 'float32', 'float64']:
+    benchmark = ArithmeticBenchmark(add, dtype = dtype, cuda = False)
+    benchmark.plot_result(loglog = True)
 
-  benchmark = NumPyArithmeticBenchmark(add)
-  benchmark.plot_result(loglog = True)
+    benchmark = NumPyArithmeticBenchmark(add, dtype = dtype)
+    benchmark.plot_result(loglog = True)
 
 #  if cuda:
  #   benchmark = PyCUDAArithmeticBenchmark(add)
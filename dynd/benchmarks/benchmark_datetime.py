@@ -0,0 +1,88 @@
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000]
+
+def make_strings(size, time = False):
+  if time:
+    return ['{:04d}-{:02d}-{:02d}T{:02d}:{:02d}:{:02d}'.format(
+              1900 + i % 200, 1 + i % 12, 1 + i % 28, i % 24, i % 60, i % 59)
+            for i in range(size)]
+  return ['{:04d}-{:02d}-{:02d}'.format(1900 + i % 200, 1 + i % 12, 1 + i % 28)
+          for i in range(size)]
+
+class DateParseBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, time = False, threads = 1):
+    Benchmark.__init__(self)
+    self.time = time
+    self.ectx = nd.eval_context(threads = threads)
+
+  @median
+  def run(self, size):
+    a = nd.array(make_strings(size, self.time))
+    a = a.ucast(ndt.type('datetime') if self.time else ndt.date)
+
+    with Timer() as timer:
+      a.eval(ectx = self.ectx)
+
+    return timer.elapsed_time()
+
+class NumPyDateParseBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, time = False):
+    Benchmark.__init__(self)
+    self.time = time
+
+  @median
+  def run(self, size):
+    import numpy as np
+
+    a = np.array(make_strings(size, self.time))
+
+    with Timer() as timer:
+      a.astype('M8[s]' if self.time else 'M8[D]')
+
+    return timer.elapsed_time()
+
+class PandasDateParseBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, time = False):
+    Benchmark.__init__(self)
+    self.time = time
+
+  @median
+  def run(self, size):
+    import pandas as pd
+
+    a = pd.Series(make_strings(size, self.time))
+
+    with Timer() as timer:
+      pd.to_datetime(a)
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for time in [False, True]:
+    for threads in [1, 0]:
+      benchmark = DateParseBenchmark(time = time, threads = threads)
+      benchmark.plot_result(loglog = True)
+
+    benchmark = NumPyDateParseBenchmark(time = time)
+    benchmark.plot_result(loglog = True)
+
+    benchmark = PandasDateParseBenchmark(time = time)
+    benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
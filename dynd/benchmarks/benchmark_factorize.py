@@ -0,0 +1,66 @@
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000]
+
+def make_values(size, strings = False):
+  if strings:
+    return ['item-{}'.format((i * 7919) % 1000) for i in range(size)]
+  return [(i * 7919) % 1000 for i in range(size)]
+
+class FactorizeBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, strings = False, sort = True):
+    Benchmark.__init__(self)
+    self.strings = strings
+    self.sort = sort
+
+  @median
+  def run(self, size):
+    a = nd.array(make_values(size, self.strings),
+                 dtype = ndt.string if self.strings else ndt.int64)
+
+    with Timer() as timer:
+      nd.factorize(a, sort = self.sort)
+
+    return timer.elapsed_time()
+
+class PandasFactorizeBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, strings = False, sort = True):
+    Benchmark.__init__(self)
+    self.strings = strings
+    self.sort = sort
+
+  @median
+  def run(self, size):
+    import numpy as np
+    import pandas as pd
+
+    a = np.array(make_values(size, self.strings),
+                 dtype = object if self.strings else np.int64)
+
+    with Timer() as timer:
+      pd.factorize(a, sort = self.sort)
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for strings in [False, True]:
+    for sort in [True, False]:
+      benchmark = FactorizeBenchmark(strings = strings, sort = sort)
+      benchmark.plot_result(loglog = True)
+
+      benchmark = PandasFactorizeBenchmark(strings = strings, sort = sort)
+      benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
@@ -0,0 +1,61 @@
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000]
+
+def make_strings(size, ascii = True):
+  if ascii:
+    return ['item-{}'.format(i % 1000) for i in range(size)]
+  return [u'\xe9l\xe9ment-{}'.format(i % 1000) for i in range(size)]
+
+class StringFromPyBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, ascii = True):
+    Benchmark.__init__(self)
+    self.ascii = ascii
+
+  @median
+  def run(self, size):
+    strings = make_strings(size, self.ascii)
+    tp = ndt.type('{} * string'.format(size))
+
+    with Timer() as timer:
+      nd.array(strings, type = tp)
+
+    return timer.elapsed_time()
+
+class NumPyObjectFromPyBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, ascii = True):
+    Benchmark.__init__(self)
+    self.ascii = ascii
+
+  @median
+  def run(self, size):
+    import numpy as np
+
+    strings = make_strings(size, self.ascii)
+
+    with Timer() as timer:
+      np.array(strings, dtype = object)
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for ascii in [True, False]:
+    benchmark = StringFromPyBenchmark(ascii = ascii)
+    benchmark.plot_result(loglog = True)
+
+    benchmark = NumPyObjectFromPyBenchmark(ascii = ascii)
+    benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
@@ -134,6 +134,9 @@ def _get_lowlevel_api():
 def _get_py_lowlevel_api():
     return <size_t>dynd_get_py_lowlevel_api()
 
+# The versioned C-API for other extension modules, see pydynd_capi.h
+_C_API = make_capi_capsule()
+
 # Helper for cases where we can't use None for a missing argument default
 class UnsuppliedType(object):
     pass
@@ -1340,6 +1343,16 @@ cdef class w_array:
         #"""PEP 3118 buffer protocol"""
         array_releasebuffer_pep3118(self, buffer)
 
+    def __reduce_ex__(self, protocol):
+        """
+        Pickles the array by its type and data. Arrays of a fixed
+        layout pickle their raw data, which with protocol 5 is a
+        PickleBuffer that can be transferred out of band. Other
+        arrays, with var dimensions or strings, pickle their
+        Python value.
+        """
+        return (_array_from_pickle, array_pickle_state(self, protocol))
+
     def __add__(lhs, rhs):
         cdef w_array res = w_array()
         SET(res.v, array_add(GET(asarray(lhs).v), GET(asarray(rhs).v)))
@@ -1397,11 +1410,47 @@ cdef class w_arrfunc(w_array):
     ValueError: parameter 2 to arrfunc does not match, expected int32, received string
     """
 
+    # Instantiated ckernels, see arrfunc_ckernel_cache.hpp
+    cdef void *ckernel_cache
+
     def __init__(self, pyfunc, proto):
         SET(self.v, apply(pyfunc, proto))
 
-    #def __dealloc__(self):
-    #    placement_delete(self.v)
+    def __dealloc__(self):
+        free_arrfunc_ckernel_cache(self)
+
+    property ckernel_cache_info:
+        """
+        af.ckernel_cache_info
+
+        A dict with the 'hits', 'misses', 'evictions', 'size' and
+        'capacity' of the cache of ckernels this arrfunc has
+        instantiated for calls with concrete argument types.
+        """
+        def __get__(self):
+            return arrfunc_ckernel_cache_info(self)
+
+    property ckernel_cache_capacity:
+        """
+        af.ckernel_cache_capacity
+
+        The number of instantiated ckernels this arrfunc keeps,
+        least recently used first out. Setting it to 0 disables
+        the cache.
+        """
+        def __get__(self):
+            return arrfunc_ckernel_cache_info(self)['capacity']
+        def __set__(self, value):
+            arrfunc_ckernel_cache_set_capacity(self, value)
+
+    def clear_ckernel_cache(self):
+        """
+        af.clear_ckernel_cache()
+
+        Drops the ckernels this arrfunc has cached, and resets
+        the counters in ``ckernel_cache_info``.
+        """
+        arrfunc_ckernel_cache_clear(self)
 
     def __call__(self, *args, **kwds):
         # Handle the keyword-only arguments
@@ -1412,6 +1461,141 @@ cdef class w_arrfunc(w_array):
         return arrfunc_call(self, args, kwds, ectx)
 
 
+cdef class w_memoized_array(w_array):
+    """
+    nd.memoize(a)
+
+    Wraps a dynd array, typically one with an expression type from
+    ``nd.elwise_map`` or ``ucast``, so that its values are computed
+    only once. The first ``eval()`` materializes the values, and the
+    wrapper then holds them in place of the expression, so later
+    ``eval()`` calls and indexing read the stored values.
+
+    Once materialized, the values are an immutable copy, which no
+    longer follows changes to the data the expression reads from.
+    Call ``invalidate()`` after modifying it.
+
+    Parameters
+    ----------
+    a : dynd array
+        The array whose values are memoized.
+
+    Examples
+    --------
+    >>> from dynd import nd, ndt
+
+    >>> a = nd.array([1.5, 2, 3])
+    >>> b = nd.memoize(a.ucast(ndt.int32))
+    >>> b.eval()
+    nd.array([1, 2, 3],
+             type="3 * int32")
+    >>> b.cache_info
+    {'cached': True, 'hits': 0, 'misses': 1}
+    """
+    cdef w_array _source
+    cdef bint _cached
+    cdef intptr_t _hits
+    cdef intptr_t _misses
+
+    def __init__(self, a):
+        self._source = a if isinstance(a, w_array) else w_array(a)
+        SET(self.v, GET(self._source.v))
+
+    property source:
+        """The dynd array whose values are memoized"""
+        def __get__(self):
+            return self._source
+
+    property cache_info:
+        """
+        m.cache_info
+
+        A dict with the 'hits' and 'misses' of evaluations and
+        indexing, and whether the values are 'cached'.
+        """
+        def __get__(self):
+            return {'hits': self._hits, 'misses': self._misses,
+                    'cached': bool(self._cached)}
+
+    def invalidate(self):
+        """
+        m.invalidate()
+
+        Drops the materialized values, so the next ``eval()``
+        computes them again from the source.
+        """
+        SET(self.v, GET(self._source.v))
+        self._cached = False
+
+    def eval(self, ectx=None):
+        """
+        m.eval(ectx=<default eval_context>)
+
+        Returns the values of the source array, computing
+        them on the first call only.
+        """
+        cdef w_array result = w_array()
+        if self._cached:
+            self._hits += 1
+        else:
+            self._misses += 1
+            # Store an immutable copy, so neither writes through the
+            # returned array nor to the source can change the cache
+            SET(self.v, array_eval_copy(GET(self._source.v), 'immutable', ectx))
+            self._cached = True
+        SET(result.v, GET(self.v))
+        return result
+
+    def __getitem__(self, x):
+        cdef w_array result = w_array()
+        # Reads before the first eval() compute just the
+        # requested part from the source
+        if self._cached:
+            self._hits += 1
+        else:
+            self._misses += 1
+        SET(result.v, array_getitem(GET(self.v), x))
+        return result
+
+    def __setitem__(self, x, y):
+        raise TypeError('a memoized dynd array is read-only, assign to '
+                        'its source and call invalidate() instead')
+
+def memoize(a):
+    """
+    nd.memoize(a)
+
+    Returns a wrapper of the dynd array which computes its values
+    once, on the first ``eval()``. See ``nd.memoized_array``.
+    """
+    return w_memoized_array(a)
+
+def _array_from_pickle(type, kind, data):
+    # Reconstructs an nd.array pickled by w_array.__reduce_ex__
+    cdef w_array result = w_array()
+    SET(result.v, array_from_pickle_state(type, kind, data))
+    return result
+
+def _arrfunc_from_cfunc(cfunc):
+    # Makes an arrfunc calling the C function of a ctypes function
+    # pointer natively, see nd.functional.apply
+    return wrap_array(apply_cfunc(cfunc))
+
+def _arrfunc_from_strided_cfunc(address, owner, proto):
+    # Makes an arrfunc whose strided loops call a C function at
+    # the given address, see nd.functional.apply_strided
+    return wrap_array(apply_strided_cfunc(address, owner, proto))
+
+def _array_from_py_dynamic_stats(reset=False):
+    # Returns a dict of the promotion counters of the conversion from
+    # Python iterators, optionally resetting them, for profiling
+    return array_from_py_dynamic_stats(reset)
+
+def _simd_level():
+    # Returns the instruction set the contiguous arithmetic loops use,
+    # one of "scalar", "sse2" or "avx2", for debugging
+    return str(get_simd_level_name().decode('ascii'))
+
 def view(obj, type=None, access=None):
     """
     nd.view(obj, type=None, access=None)
@@ -1585,9 +1769,9 @@ def is_f_contiguous(w_array a):
     """
     return array_is_f_contiguous(GET(a.v))
 
-def as_py(w_array n, tuple=False):
+def as_py(w_array n, tuple=False, dedupe=False):
     """
-    nd.as_py(n, tuple=False)
+    nd.as_py(n, tuple=False, dedupe=False)
 
     Evaluates the dynd array, converting it into native Python types.
 
@@ -1602,6 +1786,10 @@ def as_py(w_array n, tuple=False):
     tuple : bool
         If true, produce tuples instead of dicts when converting
         dynd struct arrays.
+    dedupe : bool
+        If true, equal strings in the result share one Python
+        string object, which saves time and memory for string
+        data with few distinct values, such as codes or labels.
 
     Examples
     --------
@@ -1615,7 +1803,8 @@ def as_py(w_array n, tuple=False):
     [1.0, 2.0, 3.0, 4.0]
     """
     cdef bint tup = tuple
-    return array_as_py(GET(n.v), tup != 0)
+    cdef bint dd = dedupe
+    return array_as_py(GET(n.v), tup != 0, dd != 0)
 
 def as_numpy(w_array n, allow_copy=False):
     """
@@ -1941,6 +2130,80 @@ def memmap(filename, begin=None, end=None, access=None):
     SET(result.v, array_memmap(filename, begin, end, access))
     return result
 
+def shared_empty(type, name=None):
+    """
+    nd.shared_empty(type, name=None)
+
+    Creates an uninitialized array of the requested type in a
+    new POSIX shared memory object, which other processes can
+    attach to with ``nd.from_shared(name)``. The shared memory
+    object stays alive until ``nd.shared_unlink(name)`` is called.
+
+    Only types whose data does not reference other memory,
+    such as fixed dimensions of numbers or structs, are supported.
+
+    Parameters
+    ----------
+    type : dynd type
+        The full type of the array.
+    name : string, optional
+        The name of the shared memory object, which should begin
+        with a '/'. If not provided, a unique name is generated,
+        and ``nd.shared_name`` returns it.
+
+    Examples
+    --------
+    >>> from dynd import nd, ndt
+
+    >>> a = nd.shared_empty('3 * int32')
+    >>> a[...] = [1, 2, 3]
+    >>> b = nd.from_shared(nd.shared_name(a))
+    >>> b
+    nd.array([1, 2, 3],
+             type="3 * int32")
+    >>> nd.shared_unlink(nd.shared_name(a))
+    """
+    cdef w_array result = w_array()
+    SET(result.v, array_shared_empty(GET(w_type(type).v), name))
+    return result
+
+def from_shared(name, access=None):
+    """
+    nd.from_shared(name, access=None)
+
+    Attaches to an array created by ``nd.shared_empty``, mapping
+    its data without copying it.
+
+    Parameters
+    ----------
+    name : string
+        The name of the shared memory object.
+    access : 'readonly'/'r', 'readwrite'/'rw', or 'immutable', optional
+        The access control for the array. The default is 'readonly'.
+    """
+    cdef w_array result = w_array()
+    SET(result.v, array_from_shared(name, access))
+    return result
+
+def shared_name(w_array a):
+    """
+    nd.shared_name(a)
+
+    Returns the name of the shared memory object holding the
+    data of the array, or None if it is not in shared memory.
+    """
+    return array_shared_name(GET(a.v))
+
+def shared_unlink(name):
+    """
+    nd.shared_unlink(name)
+
+    Removes the name of a shared memory object created by
+    ``nd.shared_empty``. Arrays already attached to it remain
+    valid, and the memory is freed with the last of them.
+    """
+    dynd_shared_unlink(name)
+
 def groupby(data, by, groups = None):
     """
     nd.groupby(data, by, groups=None)
@@ -1992,6 +2255,44 @@ def groupby(data, by, groups = None):
             SET(result.v, dynd_groupby(GET(w_array(data).v), GET(w_array(by).v), GET(w_type(groups).v)))
     return result
 
+def factorize(values, bint sort=True):
+    """
+    nd.factorize(values, sort=True)
+
+    Encodes a one-dimensional array as the index of each element
+    in its distinct values, returning a tuple of the codes and a
+    categorical type whose categories are the distinct values.
+
+    Integer and string arrays are encoded in a single pass with a
+    hash table. Viewing the codes as the categorical type gives
+    the same array as ``values.ucast(tp)``.
+
+    Parameters
+    ----------
+    values : one-dimensional dynd array
+        The values to encode.
+    sort : bool, optional
+        If True (the default), the categories are sorted. If False,
+        the categories of integer and string arrays are in order of
+        first appearance.
+
+    Examples
+    --------
+    >>> from dynd import nd, ndt
+
+    >>> codes, tp = nd.factorize(['M', 'M', 'F', 'F', 'M', 'F', 'M'])
+    >>> codes
+    nd.array([1, 1, 0, 0, 1, 0, 1],
+             type="7 * uint8")
+    >>> tp
+    ndt.type("categorical[string, [\"F\", \"M\"]]")
+    >>> nd.factorize(['M', 'M', 'F'], sort=False)[1]
+    ndt.type("categorical[string, [\"M\", \"F\"]]")
+    """
+    cdef w_array result = w_array()
+    SET(result.v, array_factorize(GET(w_array(values).v), sort))
+    return (result.ints, dtype_of(result))
+
 def range(start=None, stop=None, step=None, dtype=None):
     """
     nd.range(stop, dtype=None)
@@ -2049,6 +2350,32 @@ def linspace(start, stop, count=50, dtype=None):
     SET(result.v, array_linspace(start, stop, count, dtype))
     return result
 
+def fromiter(iterable, dtype, count=None):
+    """
+    nd.fromiter(iterable, dtype, count=None)
+
+    Constructs a one-dimensional dynd array from the values of an
+    iterable. The values are converted as they are produced, so a
+    generator is never collected into a list first.
+
+    Parameters
+    ----------
+    iterable : iterable object
+        The object providing the values.
+    dtype : dynd type
+        The type of the values in the resulting dynd array.
+    count : int, optional
+        If provided, the number of values to read from the iterable,
+        and the result is a fixed dimension of this size, allocated
+        exactly once. Otherwise the result is a var dimension holding
+        all the values, which grows geometrically as they are read.
+    """
+    if count is None or count < 0:
+        return w_array(iter(iterable), type=make_var_dim(dtype))
+    import itertools
+    return w_array(itertools.islice(iterable, count),
+                   type=make_fixed_dim(count, dtype))
+
 def fields(w_array struct_array, *fields_list):
     """
     nd.fields(struct_array, *fields_list)
@@ -2158,9 +2485,9 @@ def rolling_apply(af, arr, window_size, ectx=None):
 def get_published_arrfuncs():
     return dynd_get_published_arrfuncs()
 
-def elwise_map(n, callable, dst_type, src_type = None):
+def elwise_map(n, callable, dst_type, src_type = None, blocksize = None):
     """
-    nd.elwise_map(n, callable, dst_type, src_type=None)
+    nd.elwise_map(n, callable, dst_type, src_type=None, blocksize=None)
 
     Applies a deferred element-wise mapping function to
     a dynd array 'n'.
@@ -2183,8 +2510,13 @@ def elwise_map(n, callable, dst_type, src_type = None):
         A list of types of the source. If a source array has
         a different type than the one corresponding in this list,
         it will be converted.
+    blocksize : int, optional
+        The most elements passed to one call of 'callable'. By
+        default each call gets a whole innermost dimension, a
+        smaller block size bounds the memory of temporaries the
+        callable creates.
     """
-    return dynd_elwise_map(n, callable, dst_type, src_type)
+    return dynd_elwise_map(n, callable, dst_type, src_type, blocksize)
 
 class DebugReprObj(object):
     def __init__(self, repr_str):
@@ -2328,7 +2660,9 @@ cdef class w_eval_context:
                     errmode=None,
                     cuda_device_errmode=None,
                     date_parse_order=None,
-                    century_window=None)
+                    century_window=None,
+                    threads=None,
+                    grainsize=None)
 
     Create a dynd evaluation context, overriding the defaults via
     the chosen parameters. Evaluation contexts can be used to
@@ -2352,10 +2686,17 @@ cdef class w_eval_context:
         Whether and how to interpret two digit years. If 0, disallow them.
         If 1-99, use a sliding window beginning that number of years ago.
         If greater than 1000, use a fixed window starting at that year.
+    threads : int, optional
+        The number of threads ``eval`` and ``eval_copy`` may split the
+        outer dimension of a conversion, view or byteswap expression
+        across. If 0, use one per hardware thread. The default is 1.
+    grainsize : int, optional
+        The fewest elements of the outer dimension given to a thread.
     """
     # NOTE: This layout is also accessed from C++
     cdef eval_context *ectx
     cdef bint own_ectx
+    cdef eval_threading threading
 
     def __cinit__(self, *args, **kwargs):
         self.own_ectx = False
@@ -2363,7 +2704,7 @@ cdef class w_eval_context:
             raise TypeError('nd.eval_context() accepts no positional args')
 
         # Start with a copy of the default eval context
-        self.ectx = new_eval_context(kwargs)
+        self.ectx = new_eval_context(kwargs, &self.threading)
         self.own_ectx = True
 
     def __dealloc__(self):
@@ -2386,6 +2727,14 @@ cdef class w_eval_context:
         def __get__(self):
             return get_eval_context_century_window(self)
 
+    property threads:
+        def __get__(self):
+            return self.threading.threads
+
+    property grainsize:
+        def __get__(self):
+            return self.threading.grainsize
+
     property _ectx_ptr:
         def __get__(self):
             return <uintptr_t>self.ectx
@@ -2402,7 +2751,9 @@ def modify_default_eval_context(**kwargs):
                     errmode=None,
                     cuda_device_errmode=None,
                     date_parse_order=None,
-                    century_window=None)
+                    century_window=None,
+                    threads=None,
+                    grainsize=None)
 
     Modify the default dynd evaluation context, overriding the defaults via
     the chosen parameters. This is not recommended for typical use
@@ -2426,5 +2777,204 @@ def modify_default_eval_context(**kwargs):
         Whether and how to interpret two digit years. If 0, disallow them.
         If 1-99, use a sliding window beginning that number of years ago.
         If greater than 1000, use a fixed window starting at that year.
+    threads : int, optional
+        The number of threads ``eval`` and ``eval_copy`` may split the
+        outer dimension of a conversion, view or byteswap expression
+        across. If 0, use one per hardware thread. The default is 1.
+    grainsize : int, optional
+        The fewest elements of the outer dimension given to a thread.
     """
     dynd_modify_default_eval_context(kwargs)
+
+cdef extern from "ckernel_builder_functions.hpp" namespace "pydynd":
+    cdef cppclass host_ckernel_builder:
+        pass
+    host_ckernel_builder *ckernel_builder_new() except +translate_exception
+    void ckernel_builder_delete(host_ckernel_builder *)
+    void ckernel_builder_reset(host_ckernel_builder *) except +translate_exception
+    void ckernel_builder_ensure_capacity(host_ckernel_builder *, intptr_t) except +translate_exception
+    void ckernel_builder_ensure_capacity_leaf(host_ckernel_builder *, intptr_t) except +translate_exception
+    uintptr_t ckernel_builder_data(host_ckernel_builder *)
+    bint ckernel_pointer_arg(object, uintptr_t *) except +translate_exception
+    bint ckernel_index_arg(object, intptr_t *)
+    void ckernel_call_single(uintptr_t, uintptr_t, uintptr_t) except +translate_exception
+    void ckernel_call_strided(uintptr_t, uintptr_t, intptr_t, uintptr_t,
+                              uintptr_t, intptr_t) except +translate_exception
+
+# The kinds of kernel prototype a CKernel calls without ctypes
+DEF CKERNEL_PROTO_OTHER = 0
+DEF CKERNEL_PROTO_SINGLE = 1
+DEF CKERNEL_PROTO_STRIDED = 2
+
+cdef class CKernel:
+    """
+    CKernel(kernel_proto, ckp)
+
+    Wraps a ckernel prefix pointer in a callable interface.
+    This object does not track ownership of where the ckernel
+    came from, that must be handled by the caller.
+
+    Kernels with the ``ExprSingleOperation`` or ``ExprStridedOperation``
+    prototypes are called directly, other prototypes, and arguments
+    like ``ctypes.byref(...)``, through ctypes.
+
+    Parameters
+    ----------
+    kernel_proto : CFUNCPTR
+        The function prototype of the kernel.
+    ckp : int
+        A raw pointer address to a CKernelPrefixStruct.
+    """
+    cdef object _kernel_proto
+    cdef uintptr_t _ckp
+    cdef int _proto_kind
+
+    def __init__(self, kernel_proto, ckp):
+        import ctypes
+        from dynd._lowlevel.ctypes_types import (ExprSingleOperation,
+                                                 ExprStridedOperation)
+        if not (isinstance(kernel_proto, builtin_type) and
+                issubclass(kernel_proto, ctypes._CFuncPtr)):
+            raise ValueError('CKernel constructor requires a ctypes '
+                             'function pointer type for kernel_proto')
+        self._kernel_proto = kernel_proto
+        self._ckp = ckp
+        if kernel_proto is ExprSingleOperation:
+            self._proto_kind = CKERNEL_PROTO_SINGLE
+        elif kernel_proto is ExprStridedOperation:
+            self._proto_kind = CKERNEL_PROTO_STRIDED
+        else:
+            self._proto_kind = CKERNEL_PROTO_OTHER
+
+    property kernel_proto:
+        def __get__(self):
+            return self._kernel_proto
+
+    property kernel_function:
+        def __get__(self):
+            import ctypes
+            from dynd._lowlevel.ctypes_types import CKernelPrefixStruct
+            return ctypes.cast(CKernelPrefixStruct.from_address(self._ckp).function,
+                               self._kernel_proto)
+
+    def __call__(self, *args):
+        cdef uintptr_t dst, src, src_stride
+        cdef intptr_t dst_stride, count
+        # Arguments the native path can't convert, like ctypes.byref(),
+        # go through ctypes
+        if self._proto_kind == CKERNEL_PROTO_SINGLE and len(args) == 2:
+            if (ckernel_pointer_arg(args[0], &dst) and
+                    ckernel_pointer_arg(args[1], &src)):
+                ckernel_call_single(self._ckp, dst, src)
+                return None
+        elif self._proto_kind == CKERNEL_PROTO_STRIDED and len(args) == 5:
+            if (ckernel_pointer_arg(args[0], &dst) and
+                    ckernel_index_arg(args[1], &dst_stride) and
+                    ckernel_pointer_arg(args[2], &src) and
+                    ckernel_pointer_arg(args[3], &src_stride) and
+                    ckernel_index_arg(args[4], &count)):
+                ckernel_call_strided(self._ckp, dst, dst_stride, src,
+                                     src_stride, count)
+                return None
+        import ctypes
+        from dynd._lowlevel.ctypes_types import CKernelPrefixStructPtr
+        return self.kernel_function(*(args +
+                        (ctypes.cast(self._ckp, CKernelPrefixStructPtr),)))
+
+cdef class CKernelBuilder:
+    """
+    CKernelBuilder(address=None)
+
+    Wraps a ckernel builder data structure as a python object.
+    Constructs an empty ckernel builder owned by this object,
+    or builds a ckernel builder python object around a
+    ckernel_builder raw pointer, borrowing its value temporarily.
+    """
+    cdef host_ckernel_builder *_ckb
+    cdef bint borrowed
+
+    def __init__(self, address=None):
+        self.close()
+        if address is None:
+            self._ckb = ckernel_builder_new()
+            self.borrowed = False
+        else:
+            self._ckb = <host_ckernel_builder *><uintptr_t>address
+            self.borrowed = True
+
+    def __dealloc__(self):
+        self.close()
+
+    cdef host_ckernel_builder *_get(self) except NULL:
+        if self._ckb == NULL:
+            raise ValueError('the ckernel builder has been closed')
+        return self._ckb
+
+    def close(self):
+        if self._ckb != NULL:
+            if not self.borrowed:
+                ckernel_builder_delete(self._ckb)
+            self._ckb = NULL
+
+    def reset(self):
+        """Resets the ckernel builder to its initial state"""
+        ckernel_builder_reset(self._get())
+
+    def ensure_capacity(self, intptr_t requested_capacity):
+        """Ensures that the ckernel has the requested
+        capacity, together with space for a minimal child
+        ckernel. Use this when building a ckernel with
+        a child.
+
+        Parameters
+        ----------
+        requested_capacity : int
+            The number of bytes the ckernel should have.
+        """
+        ckernel_builder_ensure_capacity(self._get(), requested_capacity)
+
+    def ensure_capacity_leaf(self, intptr_t requested_capacity):
+        """Ensures that the ckernel has the requested
+        capacity, with no space for a child ckernel.
+        Use this when creating a leaf ckernel.
+
+        Parameters
+        ----------
+        requested_capacity : int
+            The number of bytes the ckernel should have.
+        """
+        ckernel_builder_ensure_capacity_leaf(self._get(), requested_capacity)
+
+    property data:
+        """The pointer to the ckernel data"""
+        def __get__(self):
+            return ckernel_builder_data(self._get())
+
+    property ckb:
+        """The ckernel builder ctypes structure"""
+        def __get__(self):
+            from dynd._lowlevel.ctypes_types import CKernelBuilderStruct
+            return CKernelBuilderStruct.from_address(<uintptr_t>self._get())
+
+    property _as_parameter_:
+        """The ckernel builder pointer for ctypes calls"""
+        def __get__(self):
+            import ctypes
+            from dynd._lowlevel.ctypes_types import CKernelBuilderStructPtr
+            return ctypes.cast(<uintptr_t>self._get(), CKernelBuilderStructPtr)
+
+    def ckernel(self, kernel_proto):
+        """Returns a ckernel wrapper object for the built ckernel.
+
+        Parameters
+        ----------
+        kernel_proto : CFUNCPTR
+            The function prototype of the kernel.
+        """
+        return CKernel(kernel_proto, ckernel_builder_data(self._get()))
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self.close()
@@ -63,3 +63,6 @@ cdef extern from "utility_functions.hpp" namespace "pydynd":
 cdef extern from "py_lowlevel_api.hpp":
     void *dynd_get_lowlevel_api()
     void *dynd_get_py_lowlevel_api()
+
+cdef extern from "py_lowlevel_api.hpp" namespace "pydynd":
+    object make_capi_capsule()
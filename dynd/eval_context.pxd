@@ -17,9 +17,13 @@ cdef extern from "dynd/eval/eval_context.hpp" namespace "dynd":
         pass
 
 cdef extern from "eval_context_functions.hpp" namespace "pydynd":
+    cdef struct eval_threading:
+        Py_ssize_t threads
+        Py_ssize_t grainsize
+
     void init_w_eval_context_typeobject(object)
 
-    eval_context *new_eval_context(object) except +translate_exception
+    eval_context *new_eval_context(object, eval_threading *) except +translate_exception
     void dynd_modify_default_eval_context "pydynd::modify_default_eval_context" (object) except +translate_exception
     object get_eval_context_errmode(object) except +translate_exception
     object get_eval_context_cuda_device_errmode(object) except +translate_exception
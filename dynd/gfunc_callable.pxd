@@ -48,10 +48,16 @@ cdef extern from "dynd/func/arrfunc.hpp" namespace "dynd":
 
 cdef extern from "arrfunc_from_pyfunc.hpp" namespace "pydynd::nd::functional":
     ndarrfunc apply(object, object) except +translate_exception
+    ndarrfunc apply_cfunc(object) except +translate_exception
+    ndarrfunc apply_strided_cfunc(object, object, object) except +translate_exception
 
 cdef extern from "arrfunc_functions.hpp" namespace "pydynd":
     void init_w_arrfunc_typeobject(object)
     object arrfunc_call(object, object, object, object) except +translate_exception
+    void free_arrfunc_ckernel_cache(object)
+    object arrfunc_ckernel_cache_info(object) except +translate_exception
+    void arrfunc_ckernel_cache_clear(object) except +translate_exception
+    void arrfunc_ckernel_cache_set_capacity(object, object) except +translate_exception
     object arrfunc_rolling_apply(object, object, object, object) except +translate_exception
     object dynd_get_published_arrfuncs "pydynd::get_published_arrfuncs" () except +translate_exception
 
@@ -19,8 +19,10 @@ namespace pydynd {
  * \param n  The nd::array to convert into a PyObject*.
  * \param struct_as_pytuple  If true, converts structs into tuples, otherwise
  *                           converts them into dicts.
+ * \param dedupe_strings  If true, equal strings share one Python object.
  */
-PyObject *array_as_py(const dynd::nd::array& n, bool struct_as_pytuple);
+PyObject *array_as_py(const dynd::nd::array& n, bool struct_as_pytuple,
+                      bool dedupe_strings = false);
 
 /** Converts a uint128 into a PyLong */
 PyObject *pylong_from_uint128(const dynd::dynd_uint128& val);
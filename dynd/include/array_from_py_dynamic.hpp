@@ -30,6 +30,16 @@ namespace pydynd {
 dynd::nd::array array_from_py_dynamic(PyObject *obj,
                                       const dynd::eval::eval_context *ectx);
 
+/**
+ * Returns a dict of counters of the work array_from_py_dynamic has done
+ * promoting arrays it has already filled, for profiling: the number of
+ * dtype and dimension promotions, and the bytes of element data copied
+ * into new arrays.
+ *
+ * \param reset  If true, the counters are reset to zero afterwards.
+ */
+PyObject *array_from_py_dynamic_stats(bool reset);
+
 void init_array_from_py_dynamic();
 
 } // namespace pydynd
@@ -23,6 +23,7 @@
 #include "array_as_pep3118.hpp"
 #include "placement_wrappers.hpp"
 #include "eval_context_functions.hpp"
+#include "simd_arithmetic.hpp"
 
 namespace pydynd {
 
@@ -106,21 +107,37 @@ inline bool array_is_f_contiguous(const dynd::nd::array& n)
 
 inline dynd::nd::array array_add(const dynd::nd::array& lhs, const dynd::nd::array& rhs)
 {
+    dynd::nd::array result;
+    if (simd_binary_arithmetic(arithmetic_add, lhs, rhs, result)) {
+        return result;
+    }
     return lhs + rhs;
 }
 
 inline dynd::nd::array array_subtract(const dynd::nd::array& lhs, const dynd::nd::array& rhs)
 {
+    dynd::nd::array result;
+    if (simd_binary_arithmetic(arithmetic_subtract, lhs, rhs, result)) {
+        return result;
+    }
     return lhs - rhs;
 }
 
 inline dynd::nd::array array_multiply(const dynd::nd::array& lhs, const dynd::nd::array& rhs)
 {
+    dynd::nd::array result;
+    if (simd_binary_arithmetic(arithmetic_multiply, lhs, rhs, result)) {
+        return result;
+    }
     return lhs * rhs;
 }
 
 inline dynd::nd::array array_divide(const dynd::nd::array& lhs, const dynd::nd::array& rhs)
 {
+    dynd::nd::array result;
+    if (simd_binary_arithmetic(arithmetic_divide, lhs, rhs, result)) {
+        return result;
+    }
     return lhs / rhs;
 }
 
@@ -0,0 +1,38 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the functions behind pickling
+// nd.array instances.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/array.hpp>
+
+namespace pydynd {
+
+/**
+ * Returns the state tuple ``(type, kind, data)`` from which
+ * array_from_pickle_state reconstructs the array.
+ *
+ *  - ``type`` is the datashape string of the array's value type.
+ *  - ``kind`` is "raw" when ``data`` is a bytes object holding the
+ *    C-contiguous data, "buffer" when ``data`` is a PickleBuffer over
+ *    it (protocol 5 and up), and "py" when ``data`` is the nd.as_py
+ *    value, for types whose data references other memory blocks,
+ *    such as var dimensions and strings.
+ */
+PyObject *array_pickle_state(PyObject *a, int protocol);
+
+/**
+ * Reconstructs an array from the state made by array_pickle_state.
+ * The data of the "buffer" kind is viewed in place when it is
+ * suitably aligned, so an out of band buffer is not copied.
+ */
+dynd::nd::array array_from_pickle_state(PyObject *type, PyObject *kind,
+                                        PyObject *data);
+
+} // namespace pydynd
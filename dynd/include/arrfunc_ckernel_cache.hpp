@@ -0,0 +1,184 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines a cache of instantiated ckernels, held
+// by each nd.arrfunc object, so that repeated calls with the
+// same argument types can skip instantiating the ckernel.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dynd/func/arrfunc.hpp>
+#include <dynd/kernels/ckernel_builder.hpp>
+
+namespace pydynd {
+
+/**
+ * A ckernel instantiated for one call signature of an arrfunc. The
+ * signature is the destination type, the source types, the raw bytes
+ * of the source arrmeta, and the eval context settings.
+ */
+struct cached_ckernel {
+  dynd::ndt::type dst_tp;
+  std::vector<dynd::ndt::type> src_tp;
+  std::string src_arrmeta;
+  size_t hash;
+  dynd::eval::eval_context ectx;
+  // Copies of the destination arrmeta followed by each source
+  // arrmeta, which the ckernel was instantiated with. A ckernel may
+  // keep pointers to its arrmeta, so they must live as long as it.
+  // These types hold no memory block references, so copying the
+  // bytes is enough.
+  std::vector<std::vector<intptr_t>> arrmeta_copies;
+  // Declared after arrmeta_copies, so it is destroyed first
+  dynd::ckernel_builder<dynd::kernel_request_host> ckb;
+  // Set while the ckernel is executing, so that a reentrant
+  // call does not share it
+  bool in_use;
+
+  cached_ckernel() : hash(0), in_use(false) {}
+
+  inline dynd::expr_single_t get_single() const
+  {
+    return ckb.get()->get_function<dynd::expr_single_t>();
+  }
+};
+
+/**
+ * RAII helper which marks a cached ckernel as in use for
+ * the duration of a call.
+ */
+class cached_ckernel_use {
+  cached_ckernel *m_ck;
+
+  cached_ckernel_use(const cached_ckernel_use &);
+  cached_ckernel_use &operator=(const cached_ckernel_use &);
+
+public:
+  explicit cached_ckernel_use(cached_ckernel *ck) : m_ck(ck)
+  {
+    m_ck->in_use = true;
+  }
+
+  ~cached_ckernel_use() { m_ck->in_use = false; }
+};
+
+/**
+ * A least recently used cache of the ckernels instantiated from one
+ * arrfunc. The rules for what may be cached are:
+ *
+ *  - Only concrete types whose arrmeta holds no memory block
+ *    references qualify, see ``is_cacheable_type``. The destination
+ *    is always freshly allocated with nd::empty, so its arrmeta is
+ *    the same on every call, and the source arrmeta is compared byte
+ *    for byte.
+ *  - Everything is dropped if the arrfunc held by the object changes.
+ *  - The eval context settings are part of the key, so changing the
+ *    default eval context invalidates the entries made with it.
+ */
+class arrfunc_ckernel_cache {
+  // The arrfunc the cached ckernels were instantiated from
+  const dynd::arrfunc_type_data *m_af;
+  // Most recently used first
+  std::list<std::unique_ptr<cached_ckernel>> m_entries;
+  size_t m_capacity;
+  size_t m_hits, m_misses, m_evictions;
+
+  arrfunc_ckernel_cache(const arrfunc_ckernel_cache &);
+  arrfunc_ckernel_cache &operator=(const arrfunc_ckernel_cache &);
+
+  void check_arrfunc(const dynd::nd::arrfunc &af);
+  void shrink_to(size_t size);
+
+public:
+  static const size_t default_capacity = 16;
+
+  arrfunc_ckernel_cache()
+      : m_af(NULL), m_capacity(default_capacity), m_hits(0), m_misses(0),
+        m_evictions(0)
+  {
+  }
+
+  /**
+   * Returns true if arguments and results of this type may be
+   * used with a cached ckernel.
+   */
+  static bool is_cacheable_type(const dynd::ndt::type &tp);
+
+  /**
+   * Returns the ckernel cached for the given signature, or NULL.
+   * Counts a hit or a miss.
+   */
+  cached_ckernel *find(const dynd::nd::arrfunc &af,
+                       const dynd::ndt::type &dst_tp, intptr_t nsrc,
+                       const dynd::ndt::type *src_tp,
+                       const char *const *src_arrmeta,
+                       const dynd::eval::eval_context *ectx);
+
+  /**
+   * Instantiates a single ckernel for the given signature, and adds
+   * it to the cache, evicting the least recently used entry if full.
+   * Only call this when the cache is enabled.
+   */
+  cached_ckernel *instantiate(const dynd::nd::arrfunc &af,
+                              const dynd::ndt::type &dst_tp,
+                              const char *dst_arrmeta, intptr_t nsrc,
+                              const dynd::ndt::type *src_tp,
+                              const char *const *src_arrmeta,
+                              const dynd::eval::eval_context *ectx);
+
+  /**
+   * Drops the cached ckernels, except any currently executing,
+   * and resets the counters.
+   */
+  void clear();
+
+  bool enabled() const { return m_capacity > 0; }
+  size_t size() const { return m_entries.size(); }
+  size_t get_capacity() const { return m_capacity; }
+  void set_capacity(size_t capacity);
+  size_t get_hits() const { return m_hits; }
+  size_t get_misses() const { return m_misses; }
+  size_t get_evictions() const { return m_evictions; }
+};
+
+/**
+ * Returns the ckernel cache of an nd.arrfunc object,
+ * creating it if necessary.
+ */
+arrfunc_ckernel_cache *get_arrfunc_ckernel_cache(PyObject *af_obj);
+
+/**
+ * Frees the ckernel cache of an nd.arrfunc object, called
+ * when the object is deallocated.
+ */
+void free_arrfunc_ckernel_cache(PyObject *af_obj);
+
+/**
+ * Returns a dict with the 'hits', 'misses', 'evictions', 'size'
+ * and 'capacity' of an nd.arrfunc object's ckernel cache.
+ */
+PyObject *arrfunc_ckernel_cache_info(PyObject *af_obj);
+
+/**
+ * Drops all the ckernels cached by an nd.arrfunc object, and
+ * resets its counters.
+ */
+void arrfunc_ckernel_cache_clear(PyObject *af_obj);
+
+/**
+ * Sets the number of ckernels an nd.arrfunc object caches,
+ * 0 disables the cache.
+ */
+void arrfunc_ckernel_cache_set_capacity(PyObject *af_obj,
+                                        PyObject *capacity_obj);
+
+} // namespace pydynd
@@ -20,6 +20,40 @@ namespace nd {
       return apply(pyfunc, make_ndt_type_from_pyobject(proto));
     }
 
+    /**
+     * Makes an arrfunc which calls the C function of a ctypes function
+     * pointer directly, with its argtypes and restype as the prototype.
+     * The function must take one to three parameters, all of the same
+     * 32 or 64-bit integer or floating point type as its return.
+     */
+    dynd::nd::arrfunc apply_cfunc(PyObject *cfunc);
+
+    /**
+     * Makes an arrfunc from a C function with the signature of the
+     * strided slot of a ckernel,
+     *
+     *   void f(char *dst, intptr_t dst_stride, char **src,
+     *          intptr_t *src_stride, size_t count);
+     *
+     * which is called directly for each strided loop. The types in the
+     * prototype must not need arrmeta, as the function receives none.
+     *
+     * \param address  The address of the function, as a Python int.
+     * \param owner  An object to keep alive as long as the arrfunc,
+     *               such as the ctypes function pointer.
+     * \param proto  The prototype of the arrfunc.
+     */
+    dynd::nd::arrfunc apply_strided_cfunc(PyObject *address, PyObject *owner,
+                                          const dynd::ndt::type &proto);
+
+    inline dynd::nd::arrfunc apply_strided_cfunc(PyObject *address,
+                                                 PyObject *owner,
+                                                 PyObject *proto)
+    {
+      return apply_strided_cfunc(address, owner,
+                                 make_ndt_type_from_pyobject(proto));
+    }
+
   } // namespace pydynd::nd::functional
 } // namespace pydynd::nd
 } // namespace pydynd
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "placement_wrappers.hpp"
 #include "eval_context_functions.hpp"
 #include "array_functions.hpp"
+#include "arrfunc_ckernel_cache.hpp"
 
 namespace pydynd {
 
@@ -39,6 +40,8 @@ struct WArrFunc {
   PyObject_HEAD;
   // This is array_placement_wrapper in Cython-land
   dynd::nd::arrfunc v;
+  // Created on the first call, freed by w_arrfunc.__dealloc__
+  arrfunc_ckernel_cache *ckernel_cache;
 };
 void init_w_arrfunc_typeobject(PyObject *type);
 
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the functions behind the CKernelBuilder and
+// CKernel types of dynd._pydynd, which build ckernels in a host
+// ckernel_builder and call them without going through ctypes.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/kernels/ckernel_builder.hpp>
+
+namespace pydynd {
+
+typedef dynd::ckernel_builder<dynd::kernel_request_host> host_ckernel_builder;
+
+/**
+ * Allocates and constructs an empty host ckernel_builder.
+ */
+host_ckernel_builder *ckernel_builder_new();
+
+/**
+ * Destructs and frees a ckernel_builder from ckernel_builder_new.
+ */
+void ckernel_builder_delete(host_ckernel_builder *ckb);
+
+void ckernel_builder_reset(host_ckernel_builder *ckb);
+
+void ckernel_builder_ensure_capacity(host_ckernel_builder *ckb,
+                                     intptr_t requested_capacity);
+
+void ckernel_builder_ensure_capacity_leaf(host_ckernel_builder *ckb,
+                                          intptr_t requested_capacity);
+
+/**
+ * The address of the root ckernel in the builder.
+ */
+inline uintptr_t ckernel_builder_data(host_ckernel_builder *ckb)
+{
+  return reinterpret_cast<uintptr_t>(ckb->get());
+}
+
+/**
+ * Converts a Python argument for a pointer parameter of a ckernel to
+ * an address. Accepts None, an integer address, or a ctypes pointer,
+ * array, struct, union or ``c_void_p`` style object. Returns false
+ * for anything else, such as ``ctypes.byref(...)`` or ``bytes``,
+ * which the caller passes through ctypes instead.
+ */
+bool ckernel_pointer_arg(PyObject *obj, uintptr_t *out);
+
+/**
+ * Converts a Python int for an ``intptr_t`` parameter of a ckernel.
+ * Returns false for anything else, which the caller passes through
+ * ctypes instead.
+ */
+bool ckernel_index_arg(PyObject *obj, intptr_t *out);
+
+/**
+ * Calls the ckernel at ``ckp`` as an ``expr_single_t``.
+ */
+void ckernel_call_single(uintptr_t ckp, uintptr_t dst, uintptr_t src);
+
+/**
+ * Calls the ckernel at ``ckp`` as an ``expr_strided_t``.
+ */
+void ckernel_call_strided(uintptr_t ckp, uintptr_t dst, intptr_t dst_stride,
+                          uintptr_t src, uintptr_t src_stride, intptr_t count);
+
+} // namespace pydynd
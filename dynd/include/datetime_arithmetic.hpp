@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the calendar arithmetic shared by the Python
+// datetime conversions and the ISO 8601 parser. It has no Python
+// dependencies.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+namespace pydynd {
+
+// The dynd datetime type counts ticks of 100 nanoseconds
+static const int64_t datetime_ticks_per_second = 10000000LL;
+static const int64_t datetime_ticks_per_day = 86400LL * 10000000LL;
+
+/**
+ * Returns the number of days since 1970-01-01 of a date in the
+ * proleptic Gregorian calendar, using the arithmetic days from civil
+ * algorithm, which has no table lookups or loops.
+ */
+inline int32_t days_from_civil(int32_t year, int32_t month, int32_t day)
+{
+  year -= month <= 2;
+  const int32_t era = (year >= 0 ? year : year - 399) / 400;
+  // Year, day of year and day of the 400 year era
+  const uint32_t yoe = static_cast<uint32_t>(year - era * 400);
+  const uint32_t doy =
+      (153 * static_cast<uint32_t>(month > 2 ? month - 3 : month + 9) + 2) /
+          5 +
+      static_cast<uint32_t>(day) - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+/**
+ * Splits a number of days since 1970-01-01 into a date in the
+ * proleptic Gregorian calendar, the inverse of days_from_civil.
+ */
+inline void civil_from_days(int32_t days, int32_t &year, int32_t &month,
+                            int32_t &day)
+{
+  days += 719468;
+  const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  // Day of the 400 year era, year of the era and day of that year
+  const uint32_t doe = static_cast<uint32_t>(days - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  // The month, counting from March
+  const uint32_t mp = (5 * doy + 2) / 153;
+  day = static_cast<int32_t>(doy - (153 * mp + 2) / 5 + 1);
+  month = static_cast<int32_t>(mp < 10 ? mp + 3 : mp - 9);
+  year = static_cast<int32_t>(yoe) + era * 400 + (month <= 2);
+}
+
+} // namespace pydynd
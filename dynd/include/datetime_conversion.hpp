@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the arithmetic used to convert between Python
+// datetime.date and datetime.datetime objects and the dynd date and
+// datetime representations. The translation unit must have called
+// PyDateTime_IMPORT.
+//
+
+#pragma once
+
+#include <Python.h>
+#include <datetime.h>
+
+#include <dynd/types/datetime_type.hpp>
+
+#include "datetime_arithmetic.hpp"
+#include "utility_functions.hpp"
+
+namespace pydynd {
+
+inline bool pydatetime_is_aware(PyObject *obj)
+{
+  return ((PyDateTime_DateTime *)obj)->hastzinfo &&
+         ((PyDateTime_DateTime *)obj)->tzinfo != NULL &&
+         ((PyDateTime_DateTime *)obj)->tzinfo != Py_None;
+}
+
+/**
+ * Converts a datetime.timedelta into ticks.
+ */
+inline int64_t pytimedelta_to_ticks(PyObject *obj)
+{
+  const PyDateTime_Delta *delta = (const PyDateTime_Delta *)obj;
+  return delta->days * datetime_ticks_per_day +
+         delta->seconds * datetime_ticks_per_second +
+         delta->microseconds * DYND_TICKS_PER_MICROSECOND;
+}
+
+/**
+ * Returns the UTC offset of an aware datetime in ticks.
+ */
+inline int64_t pydatetime_utcoffset_ticks(PyObject *obj)
+{
+  pyobject_ownref offset(PyObject_CallMethod(obj, (char *)"utcoffset", NULL));
+  if (offset.get() == Py_None) {
+    return 0;
+  }
+  if (!PyDelta_Check(offset.get())) {
+    throw dynd::type_error("datetime.utcoffset() did not return a timedelta");
+  }
+  return pytimedelta_to_ticks(offset.get());
+}
+
+inline int32_t pydate_to_days(PyObject *obj)
+{
+  return days_from_civil(PyDateTime_GET_YEAR(obj), PyDateTime_GET_MONTH(obj),
+                         PyDateTime_GET_DAY(obj));
+}
+
+/**
+ * Converts the fields of a datetime.datetime into ticks since
+ * 1970-01-01T00:00, ignoring any tzinfo.
+ */
+inline int64_t pydatetime_to_local_ticks(PyObject *obj)
+{
+  int64_t seconds = PyDateTime_DATE_GET_HOUR(obj) * 3600 +
+                    PyDateTime_DATE_GET_MINUTE(obj) * 60 +
+                    PyDateTime_DATE_GET_SECOND(obj);
+  return pydate_to_days(obj) * datetime_ticks_per_day +
+         seconds * datetime_ticks_per_second +
+         PyDateTime_DATE_GET_MICROSECOND(obj) * DYND_TICKS_PER_MICROSECOND;
+}
+
+/**
+ * Converts a datetime.datetime into ticks, shifting an aware
+ * datetime to UTC.
+ */
+inline int64_t pydatetime_to_ticks(PyObject *obj)
+{
+  int64_t ticks = pydatetime_to_local_ticks(obj);
+  if (pydatetime_is_aware(obj)) {
+    ticks -= pydatetime_utcoffset_ticks(obj);
+  }
+  return ticks;
+}
+
+/**
+ * Makes a datetime.date from a number of days since 1970-01-01.
+ */
+inline PyObject *pydate_from_days(int32_t days)
+{
+  int32_t year, month, day;
+  civil_from_days(days, year, month, day);
+  return PyDate_FromDate(year, month, day);
+}
+
+/**
+ * Makes a naive datetime.datetime from ticks since 1970-01-01T00:00,
+ * dropping the ticks below a microsecond.
+ */
+inline PyObject *pydatetime_from_ticks(int64_t ticks)
+{
+  // Floor division, so the time of day is never negative
+  int64_t days = ticks / datetime_ticks_per_day;
+  int64_t rem = ticks - days * datetime_ticks_per_day;
+  if (rem < 0) {
+    --days;
+    rem += datetime_ticks_per_day;
+  }
+  int32_t year, month, day;
+  civil_from_days(static_cast<int32_t>(days), year, month, day);
+  int32_t seconds = static_cast<int32_t>(rem / datetime_ticks_per_second);
+  int32_t usecond = static_cast<int32_t>(
+      (rem % datetime_ticks_per_second) / DYND_TICKS_PER_MICROSECOND);
+  return PyDateTime_FromDateAndTime(year, month, day, seconds / 3600,
+                                    (seconds / 60) % 60, seconds % 60,
+                                    usecond);
+}
+
+/**
+ * A small direct mapped cache from date or datetime values to the
+ * Python objects made for them, so a column with repeated values
+ * shares one object per distinct value instead of allocating one
+ * per element. The slots are allocated on first use. It must be
+ * used with the GIL held.
+ */
+template <typename T>
+class pyobject_value_cache {
+  static const int slot_bits = 8;
+
+  struct entry {
+    T key;
+    PyObject *obj;
+  };
+  entry *m_entries;
+
+  pyobject_value_cache(const pyobject_value_cache &);
+  pyobject_value_cache &operator=(const pyobject_value_cache &);
+
+  static inline size_t slot(T key)
+  {
+    // Fibonacci hashing spreads runs of consecutive values
+    return static_cast<size_t>((static_cast<uint64_t>(key) *
+                                0x9E3779B97F4A7C15ULL) >>
+                               (64 - slot_bits));
+  }
+
+public:
+  pyobject_value_cache() : m_entries(NULL) {}
+
+  ~pyobject_value_cache()
+  {
+    if (m_entries != NULL) {
+      PyGILState_RAII pgs;
+      for (size_t i = 0; i != (size_t(1) << slot_bits); ++i) {
+        Py_XDECREF(m_entries[i].obj);
+      }
+      delete[] m_entries;
+    }
+  }
+
+  /**
+   * Returns a new reference to the object for ``key``, calling
+   * ``make(key)`` for a value not in the cache.
+   */
+  template <typename MakeFn>
+  inline PyObject *get(T key, MakeFn make)
+  {
+    if (m_entries == NULL) {
+      m_entries = new entry[size_t(1) << slot_bits]();
+    }
+    entry &e = m_entries[slot(key)];
+    if (e.obj == NULL || e.key != key) {
+      PyObject *obj = make(key);
+      if (obj == NULL) {
+        return NULL;
+      }
+      Py_XDECREF(e.obj);
+      e.key = key;
+      e.obj = obj;
+    }
+    Py_INCREF(e.obj);
+    return e.obj;
+  }
+};
+
+/**
+ * Converts a batch of Python objects to dates and datetimes. The
+ * types which passed the datetime module checks are remembered, so
+ * a run of objects of one type is checked with a pointer comparison,
+ * and so is the UTC offset of a fixed offset ``datetime.timezone``.
+ * Only use one for the duration of a single batch, while the
+ * objects it has seen are alive.
+ */
+class pydatetime_converter {
+  PyTypeObject *m_datetime_tp;
+  PyTypeObject *m_date_tp;
+  PyObject *m_tzinfo;
+  int64_t m_tzinfo_offset;
+
+public:
+  pydatetime_converter()
+      : m_datetime_tp(NULL), m_date_tp(NULL), m_tzinfo(NULL),
+        m_tzinfo_offset(0)
+  {
+  }
+
+  inline bool is_datetime(PyObject *obj)
+  {
+    if (Py_TYPE(obj) == m_datetime_tp) {
+      return true;
+    }
+    else if (PyDateTime_Check(obj)) {
+      m_datetime_tp = Py_TYPE(obj);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Returns true for a datetime.date which is not a datetime.datetime.
+   */
+  inline bool is_date(PyObject *obj)
+  {
+    if (Py_TYPE(obj) == m_date_tp) {
+      return true;
+    }
+    else if (PyDate_Check(obj) && !PyDateTime_Check(obj)) {
+      m_date_tp = Py_TYPE(obj);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Converts a datetime.datetime to ticks, shifting
+   * an aware datetime to UTC.
+   */
+  inline int64_t to_ticks(PyObject *obj)
+  {
+    int64_t ticks = pydatetime_to_local_ticks(obj);
+    if (pydatetime_is_aware(obj)) {
+      PyObject *tzinfo = ((PyDateTime_DateTime *)obj)->tzinfo;
+      if (tzinfo == m_tzinfo) {
+        ticks -= m_tzinfo_offset;
+      }
+      else {
+        int64_t offset = pydatetime_utcoffset_ticks(obj);
+#if PY_VERSION_HEX >= 0x03070000
+        // Only a datetime.timezone has the same offset for every datetime
+        if (Py_TYPE(tzinfo) == Py_TYPE(PyDateTime_TimeZone_UTC)) {
+          m_tzinfo = tzinfo;
+          m_tzinfo_offset = offset;
+        }
+#endif
+        ticks -= offset;
+      }
+    }
+    return ticks;
+  }
+};
+
+} // namespace pydynd
@@ -0,0 +1,149 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines a parser for the common ISO 8601 forms of dates
+// and datetimes, used to evaluate string columns cast to date or
+// datetime without going through the general dynd date parser for
+// every element.
+//
+
+#pragma once
+
+#include <dynd/array.hpp>
+
+#include "datetime_arithmetic.hpp"
+#include "eval_context_functions.hpp"
+
+namespace pydynd {
+
+namespace detail {
+
+/**
+ * Parses exactly ``ndigits`` decimal digits.
+ */
+inline bool parse_fixed_digits(const char *s, int ndigits, int32_t &out)
+{
+  int32_t value = 0;
+  for (int i = 0; i < ndigits; ++i) {
+    uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(s[i])) -
+                     static_cast<uint32_t>('0');
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + static_cast<int32_t>(digit);
+  }
+  out = value;
+  return true;
+}
+
+inline int32_t days_in_month(int32_t year, int32_t month)
+{
+  static const int32_t days[12] = {31, 28, 31, 30, 31, 30,
+                                   31, 31, 30, 31, 30, 31};
+  if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+    return 29;
+  }
+  return days[month - 1];
+}
+
+} // namespace detail
+
+/**
+ * Parses a date of the form ``YYYY-MM-DD`` into days since 1970-01-01.
+ * Returns false for anything else, including out of range fields, so
+ * the caller can fall back to the general dynd parser. The general
+ * parser reads this form the same way for any date_parse_order and
+ * century_window.
+ */
+inline bool parse_iso8601_date(const char *begin, const char *end,
+                               int32_t &out_days)
+{
+  int32_t year, month, day;
+  if (end - begin != 10 || begin[4] != '-' || begin[7] != '-' ||
+      !detail::parse_fixed_digits(begin, 4, year) ||
+      !detail::parse_fixed_digits(begin + 5, 2, month) ||
+      !detail::parse_fixed_digits(begin + 8, 2, day)) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 ||
+      day > detail::days_in_month(year, month)) {
+    return false;
+  }
+  out_days = days_from_civil(year, month, day);
+  return true;
+}
+
+/**
+ * Parses a datetime of the form ``YYYY-MM-DD``, ``YYYY-MM-DDTHH:MM``,
+ * ``YYYY-MM-DDTHH:MM:SS`` or ``YYYY-MM-DDTHH:MM:SS.fffffff``, where
+ * the ``T`` may also be a space, into ticks since 1970-01-01T00:00.
+ * The fraction has up to 7 digits, the resolution of a tick. Returns
+ * false for anything else, including time zones, so the caller can
+ * fall back to the general dynd parser.
+ */
+inline bool parse_iso8601_datetime(const char *begin, const char *end,
+                                   int64_t &out_ticks)
+{
+  intptr_t len = end - begin;
+  int32_t days;
+  if (len == 10) {
+    if (!parse_iso8601_date(begin, end, days)) {
+      return false;
+    }
+    out_ticks = days * datetime_ticks_per_day;
+    return true;
+  }
+
+  // The format is detected from the length and the separators
+  int32_t hour, minute, second = 0, fraction = 0;
+  if (len < 16 || (begin[10] != 'T' && begin[10] != ' ') ||
+      begin[13] != ':' || !parse_iso8601_date(begin, begin + 10, days) ||
+      !detail::parse_fixed_digits(begin + 11, 2, hour) ||
+      !detail::parse_fixed_digits(begin + 14, 2, minute)) {
+    return false;
+  }
+  if (len > 16) {
+    if (len < 19 || begin[16] != ':' ||
+        !detail::parse_fixed_digits(begin + 17, 2, second)) {
+      return false;
+    }
+    if (len > 19) {
+      int ndigits = static_cast<int>(len - 20);
+      if (begin[19] != '.' || ndigits < 1 || ndigits > 7 ||
+          !detail::parse_fixed_digits(begin + 20, ndigits, fraction)) {
+        return false;
+      }
+      for (int i = ndigits; i < 7; ++i) {
+        fraction *= 10;
+      }
+    }
+  }
+  if (hour > 23 || minute > 59 || second > 59) {
+    return false;
+  }
+  out_ticks = days * datetime_ticks_per_day +
+              (hour * 3600 + minute * 60 + second) * datetime_ticks_per_second +
+              fraction;
+  return true;
+}
+
+/**
+ * Returns true if ``n`` is a one dimensional fixed array of utf8 or
+ * ascii strings cast to date or to a datetime without a time zone,
+ * which eval_string_to_datetime_column can evaluate.
+ */
+bool is_string_to_datetime_column(const dynd::nd::array &n);
+
+/**
+ * Evaluates a column accepted by is_string_to_datetime_column. Each
+ * string is parsed with the ISO 8601 parsers above, falling back to
+ * the dynd conversion using ``ectx`` for other forms. The column is
+ * split into chunks parsed in parallel, as set by ``threading``.
+ */
+dynd::nd::array
+eval_string_to_datetime_column(const dynd::nd::array &n,
+                               const dynd::eval::eval_context *ectx,
+                               const eval_threading &threading);
+
+} // namespace pydynd
@@ -29,8 +29,11 @@ namespace pydynd {
  * \param callable  The Python callable which does the mapping.
  * \param dst_type  A dynd type for the destination elements.
  * \param src_type  A dynd type for the source elements.
+ * \param blocksize  None, or the most elements to pass to
+ *                   one call of the callable.
  */
-PyObject *elwise_map(PyObject *n_obj, PyObject *callable, PyObject *dst_type, PyObject *src_type);
+PyObject *elwise_map(PyObject *n_obj, PyObject *callable, PyObject *dst_type,
+                     PyObject *src_type, PyObject *blocksize);
 
 } // namespace pydynd
 
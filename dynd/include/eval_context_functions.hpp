@@ -17,6 +17,27 @@
 
 namespace pydynd {
 
+/**
+ * How evaluation may be split across threads. This is kept by
+ * pydynd next to each eval_context.
+ */
+struct eval_threading {
+    // The number of threads, or 0 for one per hardware thread
+    intptr_t threads;
+    // The fewest elements of the outer dimension given to a thread
+    intptr_t grainsize;
+};
+
+/**
+ * The threading settings used with eval::default_eval_context.
+ */
+extern eval_threading default_eval_threading;
+
+/**
+ * The factory threading settings, which evaluate on one thread.
+ */
+const eval_threading factory_eval_threading = {1, 16384};
+
 /**
  * This is the typeobject and struct of w_eval_context from Cython.
  */
@@ -30,7 +51,9 @@ inline bool WEvalContext_Check(PyObject *obj) {
 struct WEvalContext {
     PyObject_HEAD;
     const dynd::eval::eval_context *ectx;
-    bool own_ectx;
+    // A bint in Cython
+    int own_ectx;
+    eval_threading threading;
 };
 void init_w_eval_context_typeobject(PyObject *type);
 
@@ -45,6 +68,7 @@ inline PyObject *wrap_eval_context(const dynd::eval::eval_context *ectx) {
     result->own_ectx = false;
     result->ectx = new dynd::eval::eval_context(*ectx);
     result->own_ectx = true;
+    result->threading = default_eval_threading;
     return (PyObject *)result;
 }
 
@@ -60,12 +84,30 @@ inline const dynd::eval::eval_context *eval_context_from_pyobj(PyObject *obj)
     }
 }
 
+/**
+ * The threading settings to use with the eval context object
+ * accepted by eval_context_from_pyobj.
+ */
+inline const eval_threading &eval_threading_from_pyobj(PyObject *obj)
+{
+    if (obj == NULL || obj == Py_None) {
+        return default_eval_threading;
+    } else if (WEvalContext_Check(obj)) {
+        return ((WEvalContext *)obj)->threading;
+    } else {
+        throw std::invalid_argument(
+            "invalid ectx parameter, require an nd.eval_context()");
+    }
+}
+
 /**
  * Makes a copy of eval::default_eval_context, setting parameters
  * in the keyword args. This returns unprotected memory allocated
- * by 'new', to be wrapped up in a WEvalContext wrapper.
+ * by 'new', to be wrapped up in a WEvalContext wrapper. The
+ * threading settings go in ``out_threading``.
  */
-dynd::eval::eval_context *new_eval_context(PyObject *kwargs);
+dynd::eval::eval_context *new_eval_context(PyObject *kwargs,
+                                           eval_threading *out_threading);
 
 /**
  * Accepts parameters like new_eval_context, but changes the
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines nd.factorize, which encodes a column as a
+// categorical type and the category index of each element.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/array.hpp>
+
+namespace pydynd {
+
+/**
+ * Factorizes a one-dimensional array, returning an array of the same
+ * size whose type is a categorical of the distinct values, holding
+ * the category of each element.
+ *
+ * Integer and utf8 or ascii string columns are encoded in one pass
+ * over the data using an open addressing hash table, with the
+ * categories in order of first appearance, or sorted if ``sort`` is
+ * true. Other columns use ndt::factor_categorical, whose categories
+ * are always sorted.
+ */
+dynd::nd::array array_factorize(const dynd::nd::array &values, bool sort);
+
+} // namespace pydynd
@@ -0,0 +1,61 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the multi-threaded evaluation used by
+// nd.array.eval and nd.array.eval_copy when the eval context
+// asks for more than one thread.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <functional>
+
+#include <dynd/array.hpp>
+
+#include "eval_context_functions.hpp"
+
+namespace pydynd {
+
+/**
+ * Returns the number of chunks the outer dimension of ``n`` should be
+ * split into to evaluate it, or a value less than 2 if it should be
+ * evaluated on the calling thread.
+ *
+ * Only arrays with a fixed outer dimension, whose dtype is a chain of
+ * conversion, view and byteswap expressions, and whose evaluated type
+ * holds no memory block references, are split. The kernels of these
+ * keep no state between calls, so separate ranges of the outer
+ * dimension may be assigned at once.
+ */
+intptr_t parallel_eval_chunks(const dynd::nd::array &n,
+                              const eval_threading &threading);
+
+/**
+ * Returns the number of chunks to split ``size`` elements into for
+ * the given threading settings, at least 1.
+ */
+intptr_t parallel_chunk_count(intptr_t size, const eval_threading &threading);
+
+/**
+ * Calls ``fn(begin, end)`` for ``nchunks`` contiguous ranges covering
+ * ``[0, size)``, each on its own thread, with the GIL released. ``fn``
+ * must not touch Python objects. The first exception raised by a
+ * range is rethrown once all of them are done.
+ */
+void parallel_for_chunks(intptr_t size, intptr_t nchunks,
+                         const std::function<void(intptr_t, intptr_t)> &fn);
+
+/**
+ * Assigns ``src`` to ``dst``, which have the same outer dimension, in
+ * ``nchunks`` contiguous ranges, each on its own thread. The GIL is
+ * released while the threads run.
+ */
+void parallel_eval_assign(const dynd::nd::array &dst,
+                          const dynd::nd::array &src,
+                          const dynd::eval::eval_context *ectx,
+                          intptr_t nchunks);
+
+} // namespace pydynd
@@ -10,6 +10,7 @@
 
 #include "array_functions.hpp"
 #include "type_functions.hpp"
+#include "pydynd_capi.h"
 
 namespace pydynd {
 
@@ -57,6 +58,12 @@ struct py_lowlevel_api_t {
     PyObject *(*make_take_arrfunc)();
 };
 
+/**
+ * Returns a new PyCapsule holding the versioned C-API table
+ * described in pydynd_capi.h, exported as dynd._pydynd._C_API.
+ */
+PyObject *make_capi_capsule();
+
 } // namespace pydynd
 
 /**
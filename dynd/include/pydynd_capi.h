@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011-15 DyND Developers
+ * BSD 2-Clause License, see LICENSE.txt
+ *
+ * This header defines the C-API which dynd._pydynd exports to other
+ * C extensions through a PyCapsule. It is plain C, so it can be used
+ * from C, C++ and Cython alike. Find it with dynd.get_include().
+ *
+ * In the extension module's init function, call
+ *
+ *   const pydynd_capi_t *dynd_capi = pydynd_import_capi();
+ *   if (dynd_capi == NULL) {
+ *     return NULL;
+ *   }
+ *
+ * and keep the pointer for the lifetime of the module.
+ */
+
+#ifndef PYDYND_CAPI_H
+#define PYDYND_CAPI_H
+
+#include <Python.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The version of the table this header describes. Functions are only
+ * ever appended to the table, with a new version, so a module compiled
+ * against one version runs with dynd exporting that version or later.
+ */
+#define PYDYND_CAPI_VERSION 1
+
+/* The name of the capsule, the _C_API attribute of dynd._pydynd */
+#define PYDYND_CAPI_NAME "dynd._pydynd._C_API"
+
+/* Access flags of arrays, matching nd::read_access_flag etc in dynd */
+#define PYDYND_READ_ACCESS 0x01
+#define PYDYND_WRITE_ACCESS 0x02
+#define PYDYND_IMMUTABLE_ACCESS 0x04
+
+typedef struct {
+  uint32_t version;
+
+  /*
+   * Returns 1 if the object is an nd.array, 0 otherwise.
+   */
+  int (*array_check)(PyObject *obj);
+
+  /*
+   * Makes an nd.array viewing existing memory. With ndim 0, ``tp`` is
+   * the full type of the array, which gets default arrmeta. Otherwise
+   * ``tp`` is the element type, and the array has ``ndim`` fixed
+   * dimensions of the given shape, with the given byte strides, or
+   * C order strides if ``strides`` is NULL.
+   *
+   * ``free_owner(owner)`` is called once the last reference to the
+   * memory goes away, which may happen on a thread without the GIL.
+   * Either may be NULL when nothing needs to be released.
+   *
+   * ``tp`` is an ndt.type, or anything ndt.type accepts. Create the
+   * ndt.type once and reuse it to skip parsing on every call.
+   *
+   * Returns a new reference, or NULL with a Python error set.
+   */
+  PyObject *(*array_from_buffer)(PyObject *tp, intptr_t ndim,
+                                 const intptr_t *shape,
+                                 const intptr_t *strides, char *data,
+                                 void *owner, void (*free_owner)(void *),
+                                 uint32_t access_flags);
+
+  /*
+   * Allocates an uninitialized, writable nd.array with ``ndim`` fixed
+   * dimensions of the given shape in C order, and elements of type
+   * ``tp``.
+   *
+   * Returns a new reference, or NULL with a Python error set.
+   */
+  PyObject *(*array_empty)(PyObject *tp, intptr_t ndim,
+                           const intptr_t *shape);
+
+  /*
+   * Accessors for an nd.array. These do not check the type of their
+   * argument, use array_check first for an unknown object.
+   */
+  char *(*array_data)(PyObject *a);
+  const char *(*array_arrmeta)(PyObject *a);
+  uint32_t (*array_access_flags)(PyObject *a);
+} pydynd_capi_t;
+
+/*
+ * Imports the dynd C-API, returning NULL with a Python error set if
+ * dynd can't be imported or is older than this header.
+ */
+static inline const pydynd_capi_t *pydynd_import_capi(void)
+{
+  const pydynd_capi_t *api =
+      (const pydynd_capi_t *)PyCapsule_Import(PYDYND_CAPI_NAME, 0);
+  if (api == NULL) {
+    return NULL;
+  }
+  if (api->version < PYDYND_CAPI_VERSION) {
+    PyErr_Format(PyExc_ImportError,
+                 "dynd C-API version %u is older than version %u, which "
+                 "this module was compiled against",
+                 (unsigned int)api->version,
+                 (unsigned int)PYDYND_CAPI_VERSION);
+    return NULL;
+  }
+  return api;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* PYDYND_CAPI_H */
@@ -0,0 +1,56 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines nd.array objects whose data lives in
+// POSIX shared memory, so separate processes can attach to
+// the same array by name without copying it.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/array.hpp>
+
+namespace pydynd {
+
+/**
+ * Allocates an array of the given type in a new POSIX shared memory
+ * object. The shared memory object holds a small header with the
+ * datashape, followed by the array data, and stays alive until it is
+ * unlinked with shared_unlink, even after every mapping is released.
+ *
+ * Only types whose data holds no references to other memory blocks
+ * are supported, since pointers into a shared mapping are not valid
+ * in a process which maps it at another address.
+ *
+ * \param tp  The type of the array.
+ * \param name  The name of the shared memory object, or None to
+ *              generate a unique one.
+ */
+dynd::nd::array array_shared_empty(const dynd::ndt::type &tp, PyObject *name);
+
+/**
+ * Attaches to an array created by array_shared_empty, mapping the
+ * data of the shared memory object without copying it.
+ *
+ * \param name  The name of the shared memory object.
+ * \param access  'readonly' (the default), 'readwrite' or 'immutable'.
+ */
+dynd::nd::array array_from_shared(PyObject *name, PyObject *access);
+
+/**
+ * Returns the name of the shared memory object holding the data
+ * of the array, or None if the data is not in shared memory.
+ */
+PyObject *array_shared_name(const dynd::nd::array &n);
+
+/**
+ * Removes the name of a shared memory object. Arrays which are
+ * already attached keep working, the memory is released along
+ * with the last one.
+ */
+void shared_unlink(PyObject *name);
+
+} // namespace pydynd
@@ -0,0 +1,54 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines vectorized fast paths for the
+// elementwise arithmetic operators of nd.array.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/array.hpp>
+
+namespace pydynd {
+
+enum arithmetic_op_t {
+  arithmetic_add,
+  arithmetic_subtract,
+  arithmetic_multiply,
+  arithmetic_divide
+};
+
+/**
+ * The instruction set chosen at runtime for the contiguous
+ * arithmetic kernels.
+ */
+enum simd_level_t { simd_level_scalar, simd_level_sse2, simd_level_avx2 };
+
+/**
+ * Detects (once) the best instruction set supported by the
+ * running CPU.
+ */
+simd_level_t get_simd_level();
+
+/**
+ * Returns the name of the instruction set chosen at runtime,
+ * one of "scalar", "sse2" or "avx2".
+ */
+const char *get_simd_level_name();
+
+/**
+ * Attempts to evaluate ``lhs <op> rhs`` with a vectorized loop. This
+ * applies when both operands have the identical type, consisting of
+ * fixed dimensions over int32, int64, float32 or float64, and both are
+ * C-contiguous. Integer division is not handled here.
+ *
+ * Returns true and sets ``out`` to a newly allocated result when the
+ * fast path applied, false otherwise.
+ */
+bool simd_binary_arithmetic(arithmetic_op_t op, const dynd::nd::array &lhs,
+                            const dynd::nd::array &rhs, dynd::nd::array &out);
+
+} // namespace pydynd
@@ -0,0 +1,221 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+// This header defines the helpers used to convert between Python
+// unicode objects and the dynd string representations.
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include <dynd/string_encodings.hpp>
+
+namespace pydynd {
+
+/**
+ * Returns true if none of the bytes in [begin, end) has its high bit set,
+ * checking eight bytes at a time.
+ */
+inline bool is_ascii(const char *begin, const char *end)
+{
+  while (end - begin >= 8) {
+    uint64_t word;
+    memcpy(&word, begin, 8);
+    if ((word & 0x8080808080808080ULL) != 0) {
+      return false;
+    }
+    begin += 8;
+  }
+  for (; begin != end; ++begin) {
+    if ((*begin & 0x80) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Makes a Python unicode object from ASCII or UTF-8 data. Pure ASCII is
+ * copied straight into a new compact string, skipping the validation
+ * and character counting of the UTF-8 decoder.
+ */
+inline PyObject *pyunicode_from_utf8(const char *begin, const char *end)
+{
+#if PY_VERSION_HEX >= 0x03030000
+  if (is_ascii(begin, end)) {
+    PyObject *result = PyUnicode_New(end - begin, 127);
+    if (result != NULL) {
+      memcpy(PyUnicode_1BYTE_DATA(result), begin, end - begin);
+    }
+    return result;
+  }
+#endif
+  return PyUnicode_DecodeUTF8(begin, end - begin, NULL);
+}
+
+/**
+ * Makes a Python unicode object from ASCII data, raising an error
+ * for bytes outside of ASCII.
+ */
+inline PyObject *pyunicode_from_ascii(const char *begin, const char *end)
+{
+#if PY_VERSION_HEX >= 0x03030000
+  if (is_ascii(begin, end)) {
+    return pyunicode_from_utf8(begin, end);
+  }
+#endif
+  return PyUnicode_DecodeASCII(begin, end - begin, NULL);
+}
+
+inline PyObject *pyunicode_from_utf16(const char *begin, const char *end)
+{
+  return PyUnicode_DecodeUTF16(begin, end - begin, NULL, NULL);
+}
+
+inline PyObject *pyunicode_from_utf32(const char *begin, const char *end)
+{
+  return PyUnicode_DecodeUTF32(begin, end - begin, NULL, NULL);
+}
+
+#if PY_VERSION_HEX >= 0x03030000
+/**
+ * Returns the number of bytes in the UTF-8 encoding of a ready unicode
+ * object, counted from its characters without encoding it.
+ */
+inline intptr_t pyunicode_utf8_size(PyObject *obj)
+{
+  Py_ssize_t len = PyUnicode_GET_LENGTH(obj);
+  if (PyUnicode_IS_ASCII(obj)) {
+    return len;
+  }
+  int kind = PyUnicode_KIND(obj);
+  const void *data = PyUnicode_DATA(obj);
+  intptr_t size = len;
+  for (Py_ssize_t i = 0; i < len; ++i) {
+    Py_UCS4 ch = PyUnicode_READ(kind, data, i);
+    size += (ch >= 0x80) + (ch >= 0x800) + (ch >= 0x10000);
+  }
+  return size;
+}
+
+/**
+ * Writes the UTF-8 encoding of a ready unicode object to ``out``, which
+ * must have room for pyunicode_utf8_size(obj) bytes, and returns the end
+ * of what was written. Returns NULL for a string holding surrogates,
+ * which have no UTF-8 encoding, leaving the error to the codec.
+ */
+inline char *pyunicode_encode_utf8(PyObject *obj, char *out)
+{
+  Py_ssize_t len = PyUnicode_GET_LENGTH(obj);
+  if (PyUnicode_IS_ASCII(obj)) {
+    memcpy(out, PyUnicode_DATA(obj), len);
+    return out + len;
+  }
+  int kind = PyUnicode_KIND(obj);
+  const void *data = PyUnicode_DATA(obj);
+  for (Py_ssize_t i = 0; i < len; ++i) {
+    Py_UCS4 ch = PyUnicode_READ(kind, data, i);
+    if (ch < 0x80) {
+      *out++ = static_cast<char>(ch);
+    } else if (ch < 0x800) {
+      *out++ = static_cast<char>(0xC0 | (ch >> 6));
+      *out++ = static_cast<char>(0x80 | (ch & 0x3F));
+    } else if (ch < 0x10000) {
+      if (ch >= 0xD800 && ch <= 0xDFFF) {
+        return NULL;
+      }
+      *out++ = static_cast<char>(0xE0 | (ch >> 12));
+      *out++ = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (ch & 0x3F));
+    } else {
+      *out++ = static_cast<char>(0xF0 | (ch >> 18));
+      *out++ = static_cast<char>(0x80 | ((ch >> 12) & 0x3F));
+      *out++ = static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (ch & 0x3F));
+    }
+  }
+  return out;
+}
+#endif
+
+// Older MSVC has no C++11 thread_local, but supports it for PODs
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define PYDYND_THREAD_LOCAL __declspec(thread)
+#else
+#define PYDYND_THREAD_LOCAL thread_local
+#endif
+
+/**
+ * A table from the raw data of strings to the Python unicode objects
+ * made for them, used during one conversion to Python objects so
+ * that equal strings share one object. This saves both the decoding
+ * and the memory for columns with few distinct values.
+ *
+ * A table is made current for the kernels instantiated on the same
+ * thread within the lifetime of a pystring_dedupe_table::scope. The
+ * current table is per thread, so a conversion running on another
+ * thread while this one has released the GIL can't disturb the
+ * nesting of the scopes. It must be used and destroyed with the GIL
+ * held.
+ */
+class pystring_dedupe_table {
+  std::unordered_map<std::string, PyObject *> m_strings;
+  // Reused to build lookup keys without allocating
+  std::string m_key;
+
+  static PYDYND_THREAD_LOCAL pystring_dedupe_table *s_current;
+
+  pystring_dedupe_table(const pystring_dedupe_table &);
+  pystring_dedupe_table &operator=(const pystring_dedupe_table &);
+
+public:
+  /**
+   * The number of distinct strings remembered. Strings seen after the
+   * table is full are still converted, just not shared, so a column of
+   * unique values does not hold on to a second copy of all of them.
+   */
+  static const size_t max_size = 65536;
+
+  pystring_dedupe_table() {}
+  ~pystring_dedupe_table();
+
+  /**
+   * Returns a new reference to the unicode object for the string data
+   * in [begin, end), calling ``decode`` for a string not seen before.
+   */
+  PyObject *get(dynd::string_encoding_t encoding, const char *begin,
+                const char *end,
+                PyObject *(*decode)(const char *, const char *));
+
+  /**
+   * The table of the innermost scope on this thread, or NULL if strings
+   * should not be deduplicated.
+   */
+  static pystring_dedupe_table *current() { return s_current; }
+
+  /**
+   * Makes a table current on this thread for the lifetime of the scope.
+   */
+  class scope {
+    pystring_dedupe_table *m_prev;
+
+    scope(const scope &);
+    scope &operator=(const scope &);
+
+  public:
+    explicit scope(pystring_dedupe_table *table) : m_prev(s_current)
+    {
+      s_current = table;
+    }
+
+    ~scope() { s_current = m_prev; }
+  };
+};
+
+} // namespace pydynd
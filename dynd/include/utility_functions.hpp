@@ -137,6 +137,49 @@ public:
     }
 };
 
+/**
+ * Returns true if the calling thread holds the GIL.
+ */
+inline bool current_thread_holds_gil()
+{
+#if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check() != 0;
+#else
+    if (!PyEval_ThreadsInitialized()) {
+        return false;
+    }
+    PyThreadState *tstate = PyGILState_GetThisThreadState();
+    return tstate != NULL && tstate == _PyThreadState_Current;
+#endif
+}
+
+/**
+ * Releases the GIL for the scope of the object, if the
+ * calling thread holds it and ``release`` is true. This is the
+ * counterpart of PyGILState_RAII, for long running code
+ * which does not touch Python objects.
+ */
+class PyGILRelease_RAII {
+    PyThreadState *m_tstate;
+
+    PyGILRelease_RAII(const PyGILRelease_RAII&);
+    PyGILRelease_RAII& operator=(const PyGILRelease_RAII&);
+public:
+    inline explicit PyGILRelease_RAII(bool release = true)
+        : m_tstate(NULL)
+    {
+        if (release && current_thread_holds_gil()) {
+            m_tstate = PyEval_SaveThread();
+        }
+    }
+
+    inline ~PyGILRelease_RAII() {
+        if (m_tstate != NULL) {
+            PyEval_RestoreThread(m_tstate);
+        }
+    }
+};
+
 size_t pyobject_as_size_t(PyObject *obj);
 intptr_t pyobject_as_index(PyObject *index);
 int pyobject_as_int_index(PyObject *index);
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <memory>
+#include <sstream>
+
+#include "config.hpp"
+#include "utility_functions.hpp"
+#include <dynd/kernels/base_kernel.hpp>
+
+namespace pydynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * The number of elements above which a strided call of a C
+     * function releases the GIL.
+     */
+    static const size_t cfunc_release_gil_threshold = 4096;
+
+    struct cfunc_data {
+      // The object owning the function, such as a ctypes function
+      // pointer, which keeps the library holding it loaded
+      PyObject *cfunc;
+      void (*funcptr)();
+
+      cfunc_data(PyObject *cfunc, void (*funcptr)())
+          : cfunc(cfunc), funcptr(funcptr)
+      {
+        Py_INCREF(cfunc);
+      }
+
+      ~cfunc_data()
+      {
+        // Acquire the GIL for the python decref
+        PyGILState_RAII pgs;
+        Py_DECREF(cfunc);
+      }
+    };
+
+    template <size_t... I>
+    struct cfunc_index_sequence {
+    };
+
+    template <size_t N, size_t... I>
+    struct make_cfunc_index_sequence
+        : make_cfunc_index_sequence<N - 1, N - 1, I...> {
+    };
+
+    template <size_t... I>
+    struct make_cfunc_index_sequence<0, I...> {
+      typedef cfunc_index_sequence<I...> type;
+    };
+
+    /**
+     * A ckernel which calls a C function pointer with the signature
+     * ``R (A...)`` directly, one call per element, without touching
+     * any Python objects.
+     */
+    template <typename R, typename... A>
+    struct apply_cfunc_kernel
+        : base_kernel<apply_cfunc_kernel<R, A...>, kernel_request_host,
+                      sizeof...(A)> {
+      typedef apply_cfunc_kernel self_type;
+      typedef R (*func_type)(A...);
+      typedef typename make_cfunc_index_sequence<sizeof...(A)>::type
+          index_type;
+
+      func_type func;
+
+      apply_cfunc_kernel(func_type func) : func(func) {}
+
+      template <size_t... I>
+      void single(char *dst, char *const *src, cfunc_index_sequence<I...>)
+      {
+        *reinterpret_cast<R *>(dst) =
+            func(*reinterpret_cast<const A *>(src[I])...);
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        single(dst, src, index_type());
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src,
+                   const intptr_t *src_stride, size_t count)
+      {
+        // Let other Python threads run during a long loop
+        PyGILRelease_RAII release(count >= cfunc_release_gil_threshold);
+        char *src_copy[sizeof...(A)];
+        for (size_t j = 0; j != sizeof...(A); ++j) {
+          src_copy[j] = src[j];
+        }
+        for (size_t i = 0; i != count; ++i) {
+          single(dst, src_copy, index_type());
+          dst += dst_stride;
+          for (size_t j = 0; j != sizeof...(A); ++j) {
+            src_copy[j] += src_stride[j];
+          }
+        }
+      }
+
+      static intptr_t instantiate(
+          const arrfunc_type_data *af_self, const ndt::arrfunc_type *af_tp,
+          char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+          const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
+          intptr_t DYND_UNUSED(nsrc), const ndt::type *src_tp,
+          const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+          const eval::eval_context *DYND_UNUSED(ectx),
+          const dynd::nd::array &DYND_UNUSED(kwds),
+          const std::map<dynd::nd::string, ndt::type> &DYND_UNUSED(tp_vars))
+      {
+        if (dst_tp != af_tp->get_return_type()) {
+          std::stringstream ss;
+          ss << "destination type requested, " << dst_tp
+             << ", does not match the C function's type "
+             << af_tp->get_return_type();
+          throw type_error(ss.str());
+        }
+        for (intptr_t i = 0; i != (intptr_t)sizeof...(A); ++i) {
+          if (src_tp[i] != af_tp->get_pos_type(i)) {
+            std::stringstream ss;
+            ss << "source type requested for parameter " << (i + 1) << ", "
+               << src_tp[i] << ", does not match the C function's type "
+               << af_tp->get_pos_type(i);
+            throw type_error(ss.str());
+          }
+        }
+
+        const cfunc_data *data =
+            af_self->get_data_as<std::shared_ptr<cfunc_data>>()->get();
+        self_type::make(ckb, kernreq, ckb_offset,
+                        reinterpret_cast<func_type>(data->funcptr));
+        return ckb_offset;
+      }
+    };
+
+    /**
+     * The signature of a C function which fills the strided slot of a
+     * ckernel, matching the ``char **src`` and ``intptr_t *src_stride``
+     * of a C declaration.
+     */
+    typedef void (*cfunc_strided_t)(char *dst, intptr_t dst_stride,
+                                    char *const *src,
+                                    const intptr_t *src_stride, size_t count);
+
+    /**
+     * A ckernel which hands its strided loops to a user C function,
+     * calling it with a count of one for single elements.
+     */
+    struct apply_strided_cfunc_kernel
+        : base_kernel<apply_strided_cfunc_kernel, kernel_request_host, -1> {
+      typedef apply_strided_cfunc_kernel self_type;
+
+      // The most parameters a strided C function may take
+      static const intptr_t max_nsrc = 16;
+
+      cfunc_strided_t func;
+
+      apply_strided_cfunc_kernel(cfunc_strided_t func) : func(func) {}
+
+      void single(char *dst, char *const *src)
+      {
+        intptr_t src_stride[max_nsrc] = {0};
+        func(dst, 0, src, src_stride, 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src,
+                   const intptr_t *src_stride, size_t count)
+      {
+        // Let other Python threads run during a long loop
+        PyGILRelease_RAII release(count >= cfunc_release_gil_threshold);
+        func(dst, dst_stride, src, src_stride, count);
+      }
+
+      static intptr_t instantiate(
+          const arrfunc_type_data *af_self, const ndt::arrfunc_type *af_tp,
+          char *DYND_UNUSED(data), void *ckb, intptr_t ckb_offset,
+          const ndt::type &dst_tp, const char *DYND_UNUSED(dst_arrmeta),
+          intptr_t nsrc, const ndt::type *src_tp,
+          const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+          const eval::eval_context *DYND_UNUSED(ectx),
+          const dynd::nd::array &DYND_UNUSED(kwds),
+          const std::map<dynd::nd::string, ndt::type> &DYND_UNUSED(tp_vars))
+      {
+        if (dst_tp != af_tp->get_return_type()) {
+          std::stringstream ss;
+          ss << "destination type requested, " << dst_tp
+             << ", does not match the C function's type "
+             << af_tp->get_return_type();
+          throw type_error(ss.str());
+        }
+        for (intptr_t i = 0; i != nsrc; ++i) {
+          if (src_tp[i] != af_tp->get_pos_type(i)) {
+            std::stringstream ss;
+            ss << "source type requested for parameter " << (i + 1) << ", "
+               << src_tp[i] << ", does not match the C function's type "
+               << af_tp->get_pos_type(i);
+            throw type_error(ss.str());
+          }
+        }
+
+        const cfunc_data *data =
+            af_self->get_data_as<std::shared_ptr<cfunc_data>>()->get();
+        self_type::make(ckb, kernreq, ckb_offset,
+                        reinterpret_cast<cfunc_strided_t>(data->funcptr));
+        return ckb_offset;
+      }
+    };
+
+  } // namespace pydynd::nd::functional
+} // namespace pydynd::nd
+} // namespace pydynd
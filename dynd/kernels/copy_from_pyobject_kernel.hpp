@@ -1,20 +1,25 @@
 #pragma once
 
+#include <algorithm>
+
 #include <dynd/parser_util.hpp>
 #include <dynd/func/chain.hpp>
 #include <dynd/func/copy.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/kernels/base_virtual_kernel.hpp>
 #include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/memblock/pod_memory_block.hpp>
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/categorical_type.hpp>
 #include <dynd/types/date_type.hpp>
 #include <dynd/types/datetime_type.hpp>
 #include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
 #include <dynd/types/time_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
 #include "config.hpp"
+#include "datetime_conversion.hpp"
 
 namespace pydynd {
 namespace nd {
@@ -285,11 +290,9 @@ namespace nd {
     {
       PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
       if (PyFloat_Check(src_obj)) {
-        double v = PyFloat_AsDouble(src_obj);
-        if (v == -1 && PyErr_Occurred()) {
-          throw std::exception();
-        }
-        *reinterpret_cast<T *>(dst) = static_cast<T>(v);
+        // Reading the value of a float object can't fail
+        *reinterpret_cast<T *>(dst) =
+            static_cast<T>(PyFloat_AS_DOUBLE(src_obj));
       } else {
         *reinterpret_cast<T *>(dst) =
             array_from_py(src_obj, 0, false, &eval::default_eval_context)
@@ -437,15 +440,109 @@ namespace nd {
                     kernel_request_host, 1> {
     ndt::type dst_tp;
     const char *dst_arrmeta;
+    // Whether the UTF-8 data of an ASCII string can be copied as is
+    bool ascii_direct;
 
     copy_from_pyobject_kernel(const ndt::type &dst_tp, const char *dst_arrmeta)
         : dst_tp(dst_tp), dst_arrmeta(dst_arrmeta)
     {
+      string_encoding_t encoding =
+          dst_tp.extended<ndt::base_string_type>()->get_encoding();
+      ascii_direct =
+          (encoding == string_encoding_utf_8 ||
+           encoding == string_encoding_ascii) &&
+          reinterpret_cast<const string_type_arrmeta *>(dst_arrmeta)
+                  ->blockref != NULL;
+    }
+
+    /**
+     * Returns the characters of ``obj`` if it is a compact ASCII string
+     * which can be copied into the destination as is, or NULL. The
+     * UTF-8 data of a compact ASCII string is the string's own data,
+     * so this neither encodes nor allocates.
+     */
+    inline const char *ascii_data(PyObject *obj, Py_ssize_t &len) const
+    {
+#if PY_VERSION_HEX >= 0x03030000
+      if (ascii_direct && PyUnicode_Check(obj) && PyUnicode_IS_READY(obj) &&
+          PyUnicode_IS_COMPACT_ASCII(obj)) {
+        return PyUnicode_AsUTF8AndSize(obj, &len);
+      }
+#endif
+      (void)obj;
+      (void)len;
+      return NULL;
     }
 
     void single(char *dst, char *const *src)
     {
       PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
+      Py_ssize_t len;
+      const char *s = ascii_data(src_obj, len);
+      if (s != NULL) {
+        memory_block_data *blockref =
+            reinterpret_cast<const string_type_arrmeta *>(dst_arrmeta)
+                ->blockref;
+        string_type_data *dst_d = reinterpret_cast<string_type_data *>(dst);
+        get_memory_block_pod_allocator_api(blockref)
+            ->allocate(blockref, len, 1, &dst_d->begin, &dst_d->end);
+        memcpy(dst_d->begin, s, len);
+      } else {
+        convert(dst, src_obj);
+      }
+    }
+
+    /**
+     * Copies a batch of strings, making one allocation in the destination
+     * memory block for all the ASCII strings in it instead of one per
+     * string.
+     */
+    void strided(char *dst, intptr_t dst_stride, char *const *src,
+                 const intptr_t *src_stride, size_t count)
+    {
+      char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      size_t total_len = 0;
+      if (ascii_direct) {
+        for (size_t i = 0; i != count; ++i, src0 += src0_stride) {
+          PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src0);
+          Py_ssize_t len;
+          if (ascii_data(src_obj, len) != NULL) {
+            total_len += len;
+          }
+        }
+      }
+
+      char *arena = NULL;
+      if (total_len > 0) {
+        memory_block_data *blockref =
+            reinterpret_cast<const string_type_arrmeta *>(dst_arrmeta)
+                ->blockref;
+        char *arena_end;
+        get_memory_block_pod_allocator_api(blockref)
+            ->allocate(blockref, total_len, 1, &arena, &arena_end);
+      }
+
+      src0 = src[0];
+      for (size_t i = 0; i != count;
+           ++i, dst += dst_stride, src0 += src0_stride) {
+        PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src0);
+        Py_ssize_t len;
+        const char *s = (arena != NULL) ? ascii_data(src_obj, len) : NULL;
+        if (s != NULL) {
+          string_type_data *dst_d = reinterpret_cast<string_type_data *>(dst);
+          memcpy(arena, s, len);
+          dst_d->begin = arena;
+          dst_d->end = arena + len;
+          arena += len;
+        } else {
+          convert(dst, src_obj);
+        }
+      }
+    }
+
+    void convert(char *dst, PyObject *src_obj)
+    {
       char *pybytes_data = NULL;
       intptr_t pybytes_len = 0;
       if (PyUnicode_Check(src_obj)) {
@@ -532,21 +629,12 @@ namespace nd {
     {
     }
 
-    void single(char *dst, char *const *src)
+    inline void convert(char *dst, PyObject *src_obj,
+                        pydatetime_converter &conv)
     {
-      PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
-      if (PyDate_Check(src_obj)) {
-        const ndt::date_type *dd = dst_tp.extended<ndt::date_type>();
-        dd->set_ymd(dst_arrmeta, dst, assign_error_fractional,
-                    PyDateTime_GET_YEAR(src_obj), PyDateTime_GET_MONTH(src_obj),
-                    PyDateTime_GET_DAY(src_obj));
-      } else if (PyDateTime_Check(src_obj)) {
-        PyDateTime_DateTime *src_dt = (PyDateTime_DateTime *)src_obj;
-        if (src_dt->hastzinfo && src_dt->tzinfo != NULL) {
-          throw std::runtime_error(
-              "Converting datetimes with a timezone to dynd "
-              "arrays is not yet supported");
-        }
+      if (conv.is_date(src_obj)) {
+        *reinterpret_cast<int32_t *>(dst) = pydate_to_days(src_obj);
+      } else if (conv.is_datetime(src_obj)) {
         if (PyDateTime_DATE_GET_HOUR(src_obj) != 0 ||
             PyDateTime_DATE_GET_MINUTE(src_obj) != 0 ||
             PyDateTime_DATE_GET_SECOND(src_obj) != 0 ||
@@ -556,10 +644,7 @@ namespace nd {
              << pyobject_repr(src_obj) << " to a datetime date";
           throw std::invalid_argument(ss.str());
         }
-        const ndt::date_type *dd = dst_tp.extended<ndt::date_type>();
-        dd->set_ymd(dst_arrmeta, dst, assign_error_fractional,
-                    PyDateTime_GET_YEAR(src_obj), PyDateTime_GET_MONTH(src_obj),
-                    PyDateTime_GET_DAY(src_obj));
+        *reinterpret_cast<int32_t *>(dst) = pydate_to_days(src_obj);
       } else if (WArray_Check(src_obj)) {
         typed_data_assign(dst_tp, dst_arrmeta, dst, ((WArray *)src_obj)->v);
       } else {
@@ -569,6 +654,25 @@ namespace nd {
       }
     }
 
+    void single(char *dst, char *const *src)
+    {
+      pydatetime_converter conv;
+      convert(dst, *reinterpret_cast<PyObject *const *>(src[0]), conv);
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src,
+                 const intptr_t *src_stride, size_t count)
+    {
+      pydatetime_converter conv;
+      char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      for (size_t i = 0; i != count; ++i) {
+        convert(dst, *reinterpret_cast<PyObject *const *>(src0), conv);
+        dst += dst_stride;
+        src0 += src0_stride;
+      }
+    }
+
     static intptr_t
     instantiate(const arrfunc_type_data *af, const ndt::arrfunc_type *af_tp,
                 char *data, void *ckb, intptr_t ckb_offset,
@@ -646,24 +750,12 @@ namespace nd {
     {
     }
 
-    void single(char *dst, char *const *src)
+    inline void convert(char *dst, PyObject *src_obj,
+                        pydatetime_converter &conv)
     {
-      PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
-      if (PyDateTime_Check(src_obj)) {
-        PyDateTime_DateTime *src_dt = (PyDateTime_DateTime *)src_obj;
-        if (src_dt->hastzinfo && src_dt->tzinfo != NULL) {
-          throw std::runtime_error(
-              "Converting datetimes with a timezone to dynd "
-              "arrays is not yet supported");
-        }
-        const ndt::datetime_type *dd = dst_tp.extended<ndt::datetime_type>();
-        dd->set_cal(dst_arrmeta, dst, assign_error_fractional,
-                    PyDateTime_GET_YEAR(src_obj), PyDateTime_GET_MONTH(src_obj),
-                    PyDateTime_GET_DAY(src_obj),
-                    PyDateTime_DATE_GET_HOUR(src_obj),
-                    PyDateTime_DATE_GET_MINUTE(src_obj),
-                    PyDateTime_DATE_GET_SECOND(src_obj),
-                    PyDateTime_DATE_GET_MICROSECOND(src_obj) * 10);
+      if (conv.is_datetime(src_obj)) {
+        // An aware datetime is stored as UTC
+        *reinterpret_cast<int64_t *>(dst) = conv.to_ticks(src_obj);
       } else if (WArray_Check(src_obj)) {
         typed_data_assign(dst_tp, dst_arrmeta, dst, ((WArray *)src_obj)->v);
       } else {
@@ -673,6 +765,25 @@ namespace nd {
       }
     }
 
+    void single(char *dst, char *const *src)
+    {
+      pydatetime_converter conv;
+      convert(dst, *reinterpret_cast<PyObject *const *>(src[0]), conv);
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src,
+                 const intptr_t *src_stride, size_t count)
+    {
+      pydatetime_converter conv;
+      char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      for (size_t i = 0; i != count; ++i) {
+        convert(dst, *reinterpret_cast<PyObject *const *>(src0), conv);
+        dst += dst_stride;
+        src0 += src0_stride;
+      }
+    }
+
     static intptr_t
     instantiate(const arrfunc_type_data *af, const ndt::arrfunc_type *af_tp,
                 char *data, void *ckb, intptr_t ckb_offset,
@@ -842,6 +953,77 @@ namespace nd {
     static ndt::type make_type() { return ndt::type("(void) -> Categorical"); }
   };
 
+  /**
+   * Returns true for an iterator which can only be traversed once, such
+   * as a generator, whose items are streamed into a dimension instead
+   * of being collected in a list first.
+   */
+  inline bool is_one_pass_pyiter(PyObject *obj)
+  {
+    return PyIter_Check(obj) && !PySequence_Check(obj);
+  }
+
+  /**
+   * A batch of items taken from a Python iterator, converted together
+   * with one call of a strided child ckernel. It holds references to
+   * the items until the next fill, or its destruction.
+   */
+  class pyiter_batch {
+  public:
+    static const intptr_t max_size = 64;
+
+  private:
+    PyObject *m_items[max_size];
+    intptr_t m_size;
+
+    pyiter_batch(const pyiter_batch &);
+    pyiter_batch &operator=(const pyiter_batch &);
+
+  public:
+    pyiter_batch() : m_size(0) {}
+
+    ~pyiter_batch() { clear(); }
+
+    /**
+     * Takes up to ``count`` (at most max_size) items from the iterator,
+     * returning the number taken, which is less only at its end.
+     */
+    intptr_t fill(PyObject *iter, intptr_t count)
+    {
+      clear();
+      while (m_size < count) {
+        PyObject *item = PyIter_Next(iter);
+        if (item == NULL) {
+          if (PyErr_Occurred()) {
+            throw std::exception();
+          }
+          break;
+        }
+        m_items[m_size++] = item;
+      }
+      return m_size;
+    }
+
+    void convert(char *dst, intptr_t dst_stride, ckernel_prefix *copy_el)
+    {
+      expr_strided_t copy_el_fn = copy_el->get_function<expr_strided_t>();
+      char *src = reinterpret_cast<char *>(m_items);
+      intptr_t src_stride = sizeof(PyObject *);
+      copy_el_fn(dst, dst_stride, &src, &src_stride, m_size, copy_el);
+      if (PyErr_Occurred()) {
+        throw std::exception();
+      }
+    }
+
+    void clear()
+    {
+      for (intptr_t i = 0; i < m_size; ++i) {
+        Py_DECREF(m_items[i]);
+      }
+      m_size = 0;
+    }
+  };
+
   // TODO: Could instantiate the dst_tp -> dst_tp assignment
   //       as part of the ckernel instead of dynamically
   template <>
@@ -876,6 +1058,11 @@ namespace nd {
       ckernel_prefix *copy_el = get_child_ckernel();
       expr_strided_t copy_el_fn = copy_el->get_function<expr_strided_t>();
 
+      if (is_one_pass_pyiter(src_obj)) {
+        single_from_pyiter(dst, src_obj, copy_el);
+        return;
+      }
+
       // Get the input as an array of PyObject *
       pyobject_ownref src_fast;
       char *child_src;
@@ -915,6 +1102,44 @@ namespace nd {
       }
     }
 
+    /**
+     * Streams the items of an iterator into the dimension in batches,
+     * without collecting them in a list. A single item is broadcast
+     * like a sequence of length one.
+     */
+    void single_from_pyiter(char *dst, PyObject *src_obj,
+                            ckernel_prefix *copy_el)
+    {
+      pyiter_batch batch;
+      intptr_t i = 0;
+      while (i < m_dim_size) {
+        intptr_t count = m_dim_size - i;
+        if (count > pyiter_batch::max_size) {
+          count = pyiter_batch::max_size;
+        }
+        intptr_t n = batch.fill(src_obj, count);
+        if (n == 0) {
+          break;
+        }
+        batch.convert(dst + i * m_stride, m_stride, copy_el);
+        i += n;
+      }
+      bool exhausted = (batch.fill(src_obj, 1) == 0);
+      if (i == 1 && m_dim_size > 1 && exhausted) {
+        ckernel_prefix *copy_dst = get_child_ckernel(m_copy_dst_offset);
+        expr_strided_t copy_dst_fn = copy_dst->get_function<expr_strided_t>();
+        intptr_t zero = 0;
+        copy_dst_fn(dst + m_stride, m_stride, &dst, &zero, m_dim_size - 1,
+                    copy_dst);
+      } else if (i != m_dim_size || !exhausted) {
+        std::stringstream ss;
+        ss << "Cannot assign python iterator " << pyobject_repr(src_obj)
+           << " to a dynd " << m_dst_tp << " value, it has "
+           << (exhausted ? "too few" : "too many") << " items";
+        throw broadcast_error(ss.str());
+      }
+    }
+
     inline void destruct_children() { get_child_ckernel()->destroy(); }
 
     static intptr_t
@@ -999,6 +1224,12 @@ namespace nd {
       ckernel_prefix *copy_el = get_child_ckernel();
       expr_strided_t copy_el_fn = copy_el->get_function<expr_strided_t>();
 
+      var_dim_type_data *vdd = reinterpret_cast<var_dim_type_data *>(dst);
+      if (vdd->begin == NULL && m_offset == 0 && is_one_pass_pyiter(src_obj)) {
+        single_from_pyiter(dst, src_obj, copy_el);
+        return;
+      }
+
       // Get the input as an array of PyObject *
       pyobject_ownref src_fast;
       char *child_src;
@@ -1016,7 +1247,6 @@ namespace nd {
       }
 
       // If the var dim element hasn't been allocated, initialize it
-      var_dim_type_data *vdd = reinterpret_cast<var_dim_type_data *>(dst);
       if (vdd->begin == NULL) {
         if (m_offset != 0) {
           throw std::runtime_error(
@@ -1052,6 +1282,44 @@ namespace nd {
       }
     }
 
+    /**
+     * Streams the items of an iterator into an unallocated var dim
+     * element, growing it geometrically, then shrinks it to fit.
+     */
+    void single_from_pyiter(char *dst, PyObject *src_obj,
+                            ckernel_prefix *copy_el)
+    {
+      intptr_t capacity = 16;
+#if PY_VERSION_HEX >= 0x03040000
+      Py_ssize_t hint = PyObject_LengthHint(src_obj, capacity);
+      if (hint < 0) {
+        throw std::exception();
+      }
+      capacity = std::max(hint, (Py_ssize_t)1);
+#endif
+      dynd::ndt::var_dim_element_initialize(m_dst_tp, m_dst_arrmeta, dst,
+                                            capacity);
+      var_dim_type_data *vdd = reinterpret_cast<var_dim_type_data *>(dst);
+      pyiter_batch batch;
+      intptr_t size = 0;
+      for (;;) {
+        intptr_t n = batch.fill(src_obj, pyiter_batch::max_size);
+        if (n == 0) {
+          break;
+        }
+        if (size + n > capacity) {
+          capacity = std::max(2 * capacity, size + n);
+          dynd::ndt::var_dim_element_resize(m_dst_tp, m_dst_arrmeta, dst,
+                                            capacity);
+        }
+        batch.convert(vdd->begin + size * m_stride, m_stride, copy_el);
+        size += n;
+      }
+      if (size != capacity) {
+        dynd::ndt::var_dim_element_resize(m_dst_tp, m_dst_arrmeta, dst, size);
+      }
+    }
+
     void destruct_children() { get_child_ckernel()->destroy(); }
 
     static intptr_t
@@ -4,6 +4,8 @@
 #include <dynd/kernels/base_virtual_kernel.hpp>
 
 #include "config.hpp"
+#include "datetime_conversion.hpp"
+#include "string_conversion.hpp"
 
 namespace pydynd {
 namespace nd {
@@ -315,60 +317,63 @@ namespace nd {
     static ndt::type make_type() { return ndt::type("(char) -> void"); }
   };
 
-  struct string_ascii_copy_kernel
-      : base_kernel<string_ascii_copy_kernel, kernel_request_host, 1> {
-    void single(char *dst, char *const *src)
-    {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
-      const string_type_data *sd =
-          reinterpret_cast<const string_type_data *>(src[0]);
-      *dst_obj = PyUnicode_DecodeASCII(sd->begin, sd->end - sd->begin, NULL);
-    }
-  };
+  /**
+   * Decodes string data, sharing the result for equal strings when a
+   * pystring_dedupe_table is current at instantiation.
+   */
+  template <string_encoding_t encoding,
+            PyObject *(*decode)(const char *, const char *)>
+  struct string_copy_kernel
+      : base_kernel<string_copy_kernel<encoding, decode>, kernel_request_host,
+                    1> {
+    pystring_dedupe_table *dedupe;
 
-  struct string_utf8_copy_kernel
-      : base_kernel<string_utf8_copy_kernel, kernel_request_host, 1> {
-    void single(char *dst, char *const *src)
+    string_copy_kernel(pystring_dedupe_table *dedupe) : dedupe(dedupe) {}
+
+    inline void convert(PyObject **dst_obj, const char *begin, const char *end)
     {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
       Py_XDECREF(*dst_obj);
       *dst_obj = NULL;
-      const string_type_data *sd =
-          reinterpret_cast<const string_type_data *>(src[0]);
-      *dst_obj = PyUnicode_DecodeUTF8(sd->begin, sd->end - sd->begin, NULL);
+      if (dedupe != NULL) {
+        *dst_obj = dedupe->get(encoding, begin, end, decode);
+      } else {
+        *dst_obj = decode(begin, end);
+      }
     }
-  };
 
-  struct string_utf16_copy_kernel
-      : base_kernel<string_utf16_copy_kernel, kernel_request_host, 1> {
     void single(char *dst, char *const *src)
     {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
       const string_type_data *sd =
           reinterpret_cast<const string_type_data *>(src[0]);
-      *dst_obj =
-          PyUnicode_DecodeUTF16(sd->begin, sd->end - sd->begin, NULL, NULL);
+      convert(reinterpret_cast<PyObject **>(dst), sd->begin, sd->end);
     }
-  };
 
-  struct string_utf32_copy_kernel
-      : base_kernel<string_utf32_copy_kernel, kernel_request_host, 1> {
-    void single(char *dst, char *const *src)
+    static intptr_t instantiate(
+        const arrfunc_type_data *DYND_UNUSED(self),
+        const ndt::arrfunc_type *DYND_UNUSED(af_tp), char *DYND_UNUSED(data),
+        void *ckb, intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
+        const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
+        const ndt::type *DYND_UNUSED(src_tp),
+        const char *const *DYND_UNUSED(src_arrmeta), kernel_request_t kernreq,
+        const eval::eval_context *DYND_UNUSED(ectx),
+        const nd::array &DYND_UNUSED(kwds),
+        const std::map<nd::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
-      const string_type_data *sd =
-          reinterpret_cast<const string_type_data *>(src[0]);
-      *dst_obj =
-          PyUnicode_DecodeUTF32(sd->begin, sd->end - sd->begin, NULL, NULL);
+      string_copy_kernel::make(ckb, kernreq, ckb_offset,
+                               pystring_dedupe_table::current());
+      return ckb_offset;
     }
   };
 
+  typedef string_copy_kernel<string_encoding_ascii, &pyunicode_from_ascii>
+      string_ascii_copy_kernel;
+  typedef string_copy_kernel<string_encoding_utf_8, &pyunicode_from_utf8>
+      string_utf8_copy_kernel;
+  typedef string_copy_kernel<string_encoding_utf_16, &pyunicode_from_utf16>
+      string_utf16_copy_kernel;
+  typedef string_copy_kernel<string_encoding_utf_32, &pyunicode_from_utf32>
+      string_utf32_copy_kernel;
+
   template <>
   struct copy_to_pyobject_kernel<string_type_id>
       : base_virtual_kernel<copy_to_pyobject_kernel<string_type_id>> {
@@ -407,83 +412,37 @@ namespace nd {
     static ndt::type make_type() { return ndt::type("(string) -> void"); }
   };
 
-  struct fixed_string_ascii_copy_kernel
-      : base_kernel<fixed_string_ascii_copy_kernel, kernel_request_host, 1> {
+  /**
+   * Decodes fixed size string data up to the first NUL character, sharing
+   * the result for equal strings when a pystring_dedupe_table is current
+   * at instantiation.
+   */
+  template <string_encoding_t encoding, typename CharType,
+            PyObject *(*decode)(const char *, const char *)>
+  struct fixed_string_copy_kernel
+      : base_kernel<fixed_string_copy_kernel<encoding, CharType, decode>,
+                    kernel_request_host, 1> {
     intptr_t data_size;
+    pystring_dedupe_table *dedupe;
 
-    fixed_string_ascii_copy_kernel(intptr_t data_size) : data_size(data_size) {}
-
-    void single(char *dst, char *const *src)
-    {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
-      intptr_t size = std::find(src[0], src[0] + data_size, 0) - src[0];
-      *dst_obj = PyUnicode_DecodeASCII(src[0], size, NULL);
-    }
-
-    static intptr_t instantiate(
-        const arrfunc_type_data *DYND_UNUSED(self),
-        const ndt::arrfunc_type *DYND_UNUSED(af_tp), char *DYND_UNUSED(data),
-        void *ckb, intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
-        const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-        const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
-        kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
-        const nd::array &DYND_UNUSED(kwds),
-        const std::map<nd::string, ndt::type> &DYND_UNUSED(tp_vars))
+    fixed_string_copy_kernel(intptr_t data_size, pystring_dedupe_table *dedupe)
+        : data_size(data_size), dedupe(dedupe)
     {
-      fixed_string_ascii_copy_kernel::make(ckb, kernreq, ckb_offset,
-                                           src_tp[0].get_data_size());
-      return ckb_offset;
     }
-  };
-
-  struct fixed_string_utf8_copy_kernel
-      : base_kernel<fixed_string_utf8_copy_kernel, kernel_request_host, 1> {
-    intptr_t data_size;
-
-    fixed_string_utf8_copy_kernel(intptr_t data_size) : data_size(data_size) {}
 
     void single(char *dst, char *const *src)
     {
       PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
       Py_XDECREF(*dst_obj);
       *dst_obj = NULL;
-      intptr_t size = std::find(src[0], src[0] + data_size, 0) - src[0];
-      *dst_obj = PyUnicode_DecodeUTF8(src[0], size, NULL);
-    }
-
-    static intptr_t instantiate(
-        const arrfunc_type_data *DYND_UNUSED(self),
-        const ndt::arrfunc_type *DYND_UNUSED(af_tp), char *DYND_UNUSED(data),
-        void *ckb, intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
-        const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-        const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
-        kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
-        const nd::array &DYND_UNUSED(kwds),
-        const std::map<nd::string, ndt::type> &DYND_UNUSED(tp_vars))
-    {
-      fixed_string_utf8_copy_kernel::make(ckb, kernreq, ckb_offset,
-                                          src_tp[0].get_data_size());
-      return ckb_offset;
-    }
-  };
-
-  struct fixed_string_utf16_copy_kernel
-      : base_kernel<fixed_string_utf16_copy_kernel, kernel_request_host, 1> {
-    intptr_t data_size;
-
-    fixed_string_utf16_copy_kernel(intptr_t data_size) : data_size(data_size) {}
-
-    void single(char *dst, char *const *src)
-    {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
-      const uint16_t *char16_src = reinterpret_cast<const uint16_t *>(src[0]);
-      intptr_t size =
-          std::find(char16_src, char16_src + (data_size >> 1), 0) - char16_src;
-      *dst_obj = PyUnicode_DecodeUTF16(src[0], size * 2, NULL, NULL);
+      const CharType *char_src = reinterpret_cast<const CharType *>(src[0]);
+      const char *end = reinterpret_cast<const char *>(std::find(
+          char_src, char_src + data_size / sizeof(CharType), 0));
+      if (dedupe != NULL) {
+        *dst_obj = dedupe->get(encoding, src[0], end, decode);
+      } else {
+        *dst_obj = decode(src[0], end);
+      }
     }
 
     static intptr_t instantiate(
@@ -496,44 +455,25 @@ namespace nd {
         const nd::array &DYND_UNUSED(kwds),
         const std::map<nd::string, ndt::type> &DYND_UNUSED(tp_vars))
     {
-      fixed_string_utf16_copy_kernel::make(ckb, kernreq, ckb_offset,
-                                           src_tp[0].get_data_size());
+      fixed_string_copy_kernel::make(ckb, kernreq, ckb_offset,
+                                     src_tp[0].get_data_size(),
+                                     pystring_dedupe_table::current());
       return ckb_offset;
     }
   };
 
-  struct fixed_string_utf32_copy_kernel
-      : base_kernel<fixed_string_utf32_copy_kernel, kernel_request_host, 1> {
-    intptr_t data_size;
-
-    fixed_string_utf32_copy_kernel(intptr_t data_size) : data_size(data_size) {}
-
-    void single(char *dst, char *const *src)
-    {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-      Py_XDECREF(*dst_obj);
-      *dst_obj = NULL;
-      const uint32_t *char32_src = reinterpret_cast<const uint32_t *>(src[0]);
-      intptr_t size =
-          std::find(char32_src, char32_src + (data_size >> 2), 0) - char32_src;
-      *dst_obj = PyUnicode_DecodeUTF32(src[0], size * 4, NULL, NULL);
-    }
-
-    static intptr_t instantiate(
-        const arrfunc_type_data *DYND_UNUSED(self),
-        const ndt::arrfunc_type *DYND_UNUSED(af_tp), char *DYND_UNUSED(data),
-        void *ckb, intptr_t ckb_offset, const ndt::type &DYND_UNUSED(dst_tp),
-        const char *DYND_UNUSED(dst_arrmeta), intptr_t DYND_UNUSED(nsrc),
-        const ndt::type *src_tp, const char *const *DYND_UNUSED(src_arrmeta),
-        kernel_request_t kernreq, const eval::eval_context *DYND_UNUSED(ectx),
-        const nd::array &DYND_UNUSED(kwds),
-        const std::map<nd::string, ndt::type> &DYND_UNUSED(tp_vars))
-    {
-      fixed_string_utf32_copy_kernel::make(ckb, kernreq, ckb_offset,
-                                           src_tp[0].get_data_size());
-      return ckb_offset;
-    }
-  };
+  typedef fixed_string_copy_kernel<string_encoding_ascii, char,
+                                   &pyunicode_from_ascii>
+      fixed_string_ascii_copy_kernel;
+  typedef fixed_string_copy_kernel<string_encoding_utf_8, char,
+                                   &pyunicode_from_utf8>
+      fixed_string_utf8_copy_kernel;
+  typedef fixed_string_copy_kernel<string_encoding_utf_16, uint16_t,
+                                   &pyunicode_from_utf16>
+      fixed_string_utf16_copy_kernel;
+  typedef fixed_string_copy_kernel<string_encoding_utf_32, uint32_t,
+                                   &pyunicode_from_utf32>
+      fixed_string_utf32_copy_kernel;
 
   template <>
   struct copy_to_pyobject_kernel<fixed_string_type_id>
@@ -579,20 +519,46 @@ namespace nd {
                     1> {
     ndt::type src_tp;
     const char *src_arrmeta;
+    // Repeated dates share one datetime.date object
+    pyobject_value_cache<int32_t> cache;
 
     copy_to_pyobject_kernel(ndt::type src_tp, const char *src_arrmeta)
         : src_tp(src_tp), src_arrmeta(src_arrmeta)
     {
     }
 
-    void single(char *dst, char *const *src)
+    inline void convert(PyObject **dst_obj, const char *src)
     {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
       Py_XDECREF(*dst_obj);
       *dst_obj = NULL;
-      const ndt::date_type *dd = src_tp.extended<ndt::date_type>();
-      date_ymd ymd = dd->get_ymd(src_arrmeta, src[0]);
-      *dst_obj = PyDate_FromDate(ymd.year, ymd.month, ymd.day);
+      int32_t days = *reinterpret_cast<const int32_t *>(src);
+      if (days != DYND_DATE_NA) {
+        *dst_obj = cache.get(days, &pydate_from_days);
+      } else {
+        const ndt::date_type *dd = src_tp.extended<ndt::date_type>();
+        date_ymd ymd = dd->get_ymd(src_arrmeta, src);
+        *dst_obj = PyDate_FromDate(ymd.year, ymd.month, ymd.day);
+      }
+      if (*dst_obj == NULL) {
+        throw std::exception();
+      }
+    }
+
+    void single(char *dst, char *const *src)
+    {
+      convert(reinterpret_cast<PyObject **>(dst), src[0]);
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src,
+                 const intptr_t *src_stride, size_t count)
+    {
+      const char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      for (size_t i = 0; i != count; ++i) {
+        convert(reinterpret_cast<PyObject **>(dst), src0);
+        dst += dst_stride;
+        src0 += src0_stride;
+      }
     }
 
     static intptr_t instantiate(
@@ -660,24 +626,50 @@ namespace nd {
                     kernel_request_host, 1> {
     ndt::type src_tp;
     const char *src_arrmeta;
+    // Repeated timestamps share one datetime.datetime object
+    pyobject_value_cache<int64_t> cache;
 
     copy_to_pyobject_kernel(ndt::type src_tp, const char *src_arrmeta)
         : src_tp(src_tp), src_arrmeta(src_arrmeta)
     {
     }
 
-    void single(char *dst, char *const *src)
+    inline void convert(PyObject **dst_obj, const char *src)
     {
-      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
       Py_XDECREF(*dst_obj);
       *dst_obj = NULL;
-      const ndt::datetime_type *dd = src_tp.extended<ndt::datetime_type>();
-      int32_t year, month, day, hour, minute, second, tick;
-      dd->get_cal(src_arrmeta, src[0], year, month, day, hour, minute, second,
-                  tick);
-      int32_t usecond = tick / 10;
-      *dst_obj = PyDateTime_FromDateAndTime(year, month, day, hour, minute,
-                                            second, usecond);
+      int64_t ticks = *reinterpret_cast<const int64_t *>(src);
+      if (ticks != DYND_DATETIME_NA) {
+        *dst_obj = cache.get(ticks, &pydatetime_from_ticks);
+      } else {
+        const ndt::datetime_type *dd = src_tp.extended<ndt::datetime_type>();
+        int32_t year, month, day, hour, minute, second, tick;
+        dd->get_cal(src_arrmeta, src, year, month, day, hour, minute, second,
+                    tick);
+        int32_t usecond = tick / 10;
+        *dst_obj = PyDateTime_FromDateAndTime(year, month, day, hour, minute,
+                                              second, usecond);
+      }
+      if (*dst_obj == NULL) {
+        throw std::exception();
+      }
+    }
+
+    void single(char *dst, char *const *src)
+    {
+      convert(reinterpret_cast<PyObject **>(dst), src[0]);
+    }
+
+    void strided(char *dst, intptr_t dst_stride, char *const *src,
+                 const intptr_t *src_stride, size_t count)
+    {
+      const char *src0 = src[0];
+      intptr_t src0_stride = src_stride[0];
+      for (size_t i = 0; i != count; ++i) {
+        convert(reinterpret_cast<PyObject **>(dst), src0);
+        dst += dst_stride;
+        src0 += src0_stride;
+      }
     }
 
     static intptr_t instantiate(
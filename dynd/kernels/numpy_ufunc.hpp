@@ -1,17 +1,39 @@
 #pragma once
 
+#include <algorithm>
+
 #include "config.hpp"
+#include "utility_functions.hpp"
 #include <dynd/kernels/base_kernel.hpp>
 
 namespace pydynd {
 namespace nd {
   namespace functional {
 
+    /**
+     * The number of elements above which a strided call of a ufunc
+     * loop that does not need the GIL releases it.
+     */
+    static const size_t ufunc_release_gil_threshold = 4096;
+
+    /**
+     * The size of the stack buffer used for each argument when a
+     * strided call gathers its arguments into contiguous blocks, and
+     * the most arguments (inputs plus output) that are buffered.
+     */
+    static const intptr_t ufunc_buffer_size = 4096;
+    static const intptr_t ufunc_max_buffered_args = 4;
+
     struct scalar_ufunc_data {
       PyUFuncObject *ufunc;
       PyUFuncGenericFunction funcptr;
       void *ufunc_data;
       intptr_t param_count;
+      // The element sizes in the numpy order, inputs then the output
+      intptr_t arg_size[NPY_MAXARGS];
+      // False if the loop touches Python objects, so may not
+      // run with the GIL released
+      bool gil_safe;
 
       ~scalar_ufunc_data()
       {
@@ -21,6 +43,94 @@ namespace nd {
           Py_DECREF(ufunc);
         }
       }
+
+      /**
+       * Calls the ufunc loop over ``count`` elements. If the output is
+       * not accumulated in place and any argument is strided, the
+       * arguments are gathered into contiguous blocks first, as the
+       * numpy loops are much faster over contiguous data.
+       */
+      void call_strided(char *dst, intptr_t dst_stride, char *const *src,
+                        const intptr_t *src_stride, size_t count) const
+      {
+        char *args[NPY_MAXARGS];
+        intptr_t strides[NPY_MAXARGS];
+        memcpy(&args[0], &src[0], param_count * sizeof(void *));
+        memcpy(&strides[0], &src_stride[0], param_count * sizeof(intptr_t));
+        args[param_count] = dst;
+        strides[param_count] = dst_stride;
+
+        intptr_t nargs = param_count + 1;
+        bool buffer[NPY_MAXARGS];
+        bool any_buffered = false;
+        for (intptr_t i = 0; i < nargs; ++i) {
+          // Broadcast (zero stride) and contiguous arguments are used
+          // in place
+          buffer[i] = strides[i] != 0 && strides[i] != arg_size[i];
+          any_buffered = any_buffered || buffer[i];
+        }
+        // A zero output stride is a reduction, which the loops detect
+        // from the strides, so it is never buffered
+        if (!any_buffered || dst_stride == 0 ||
+            nargs > ufunc_max_buffered_args || count < 2) {
+          intptr_t dimsize = static_cast<intptr_t>(count);
+          funcptr(args, &dimsize, strides, ufunc_data);
+          return;
+        }
+
+        union {
+          double align;
+          char data[ufunc_buffer_size];
+        } buffers[ufunc_max_buffered_args];
+        intptr_t max_size = 1;
+        for (intptr_t i = 0; i < nargs; ++i) {
+          max_size = std::max(max_size, arg_size[i]);
+        }
+        intptr_t block = ufunc_buffer_size / max_size;
+
+        char *block_args[NPY_MAXARGS];
+        intptr_t block_strides[NPY_MAXARGS];
+        for (intptr_t i = 0; i < nargs; ++i) {
+          block_strides[i] = buffer[i] ? arg_size[i] : strides[i];
+        }
+        intptr_t remaining = static_cast<intptr_t>(count);
+        while (remaining > 0) {
+          intptr_t n = std::min(block, remaining);
+          for (intptr_t i = 0; i < param_count; ++i) {
+            if (buffer[i]) {
+              char *in = args[i];
+              char *out = buffers[i].data;
+              for (intptr_t j = 0; j < n; ++j) {
+                memcpy(out, in, arg_size[i]);
+                in += strides[i];
+                out += arg_size[i];
+              }
+              block_args[i] = buffers[i].data;
+            } else {
+              block_args[i] = args[i];
+            }
+          }
+          block_args[param_count] =
+              buffer[param_count] ? buffers[param_count].data : dst;
+
+          funcptr(block_args, &n, block_strides, ufunc_data);
+
+          if (buffer[param_count]) {
+            const char *in = buffers[param_count].data;
+            for (intptr_t j = 0; j < n; ++j) {
+              memcpy(dst, in, arg_size[param_count]);
+              in += arg_size[param_count];
+              dst += dst_stride;
+            }
+          } else {
+            dst += n * dst_stride;
+          }
+          for (intptr_t i = 0; i < param_count; ++i) {
+            args[i] += n * strides[i];
+          }
+          remaining -= n;
+        }
+      }
     };
 
     template <bool gil>
@@ -51,17 +161,10 @@ namespace nd {
       void strided(char *dst, intptr_t dst_stride, char *const *src,
                    const intptr_t *src_stride, size_t count)
       {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t strides[NPY_MAXARGS];
-        memcpy(&strides[0], &src_stride[0],
-               data->param_count * sizeof(intptr_t));
-        strides[data->param_count] = dst_stride;
-        data->funcptr(args, reinterpret_cast<intptr_t *>(&count), strides,
-                      data->ufunc_data);
+        // Let other Python threads run during a long loop
+        PyGILRelease_RAII release(data->gil_safe &&
+                                  count >= ufunc_release_gil_threshold);
+        data->call_strided(dst, dst_stride, src, src_stride, count);
       }
 
       static intptr_t instantiate(
@@ -128,20 +231,8 @@ namespace nd {
       void strided(char *dst, intptr_t dst_stride, char *const *src,
                    const intptr_t *src_stride, size_t count)
       {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t strides[NPY_MAXARGS];
-        memcpy(&strides[0], &src_stride[0],
-               data->param_count * sizeof(intptr_t));
-        strides[data->param_count] = dst_stride;
-        {
-          PyGILState_RAII pgs;
-          data->funcptr(args, reinterpret_cast<intptr_t *>(&count), strides,
-                        data->ufunc_data);
-        }
+        PyGILState_RAII pgs;
+        data->call_strided(dst, dst_stride, src, src_stride, count);
       }
 
       static intptr_t instantiate(
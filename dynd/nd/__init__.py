@@ -2,13 +2,14 @@ from __future__ import absolute_import
 
 # Expose types and functions directly from the Cython/C++ module
 from .._pydynd import w_array as array, w_arrfunc as arrfunc, \
-        w_eval_context as eval_context, \
+        w_eval_context as eval_context, w_memoized_array as memoized_array, \
         as_py, as_numpy, zeros, ones, full, empty, empty_like, range, \
-        linspace, memmap, fields, groupby, elwise_map, \
+        linspace, fromiter, memmap, shared_empty, from_shared, shared_name, \
+        shared_unlink, fields, groupby, factorize, elwise_map, \
         parse_json, format_json, debug_repr, \
         BroadcastError, type_of, dtype_of, dshape_of, ndim_of, \
         view, adapt, asarray, is_c_contiguous, is_f_contiguous, \
-        rolling_apply, modify_default_eval_context
+        rolling_apply, modify_default_eval_context, memoize
 
 # All the builtin elementwise gfuncs
 #from elwise_gfuncs import *
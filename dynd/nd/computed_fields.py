@@ -1,22 +1,83 @@
 __all__ = ['add_computed_fields']
 
+import ast
+import sys
+import numpy
+
 from dynd._pydynd import as_py, as_numpy, w_type, \
                 w_array as array, make_struct, \
                 elwise_map, extract_dtype, type_of, \
                 dtype_of, ndim_of
 
+# The operators which NumPy evaluates over whole columns
+_column_ops = (ast.Add, ast.Sub, ast.Mult, ast.Div, ast.FloorDiv, ast.Mod,
+               ast.Pow, ast.BitAnd, ast.BitOr, ast.BitXor, ast.UAdd,
+               ast.USub, ast.Invert, ast.Eq, ast.NotEq, ast.Lt, ast.LtE,
+               ast.Gt, ast.GtE)
+_column_nodes = (ast.Expression, ast.Load, ast.BinOp, ast.UnaryOp) + \
+                _column_ops
+# Literal numbers are ast.Num before Python 3.8, ast.Constant after
+_literal_nodes = tuple(getattr(ast, n) for n in ('Num', 'Constant')
+                       if hasattr(ast, n))
+_number_types = (int, float, complex) + \
+                ((long,) if sys.version_info[0] < 3 else ())
+
+def _column_expr_fields(expr, src_field_names, glbl):
+    """
+    Returns the set of fields used by the expression when it can be
+    evaluated over whole NumPy columns, or None if it has to be
+    evaluated one row at a time in Python.
+
+    The supported syntax is arithmetic, single comparisons, number
+    literals, numeric constants like pi, and calls of NumPy ufuncs
+    with positional arguments.
+    """
+    try:
+        tree = ast.parse(expr, mode='eval')
+    except (SyntaxError, TypeError):
+        return None
+    fields = set()
+    for node in ast.walk(tree):
+        if isinstance(node, _column_nodes):
+            pass
+        elif isinstance(node, _literal_nodes):
+            value = node.n if hasattr(node, 'n') else node.value
+            if isinstance(value, bool) or \
+                    not isinstance(value, _number_types):
+                return None
+        elif isinstance(node, ast.Compare):
+            if len(node.ops) != 1:
+                return None
+        elif isinstance(node, ast.Call):
+            if not (isinstance(node.func, ast.Name) and
+                    node.func.id not in src_field_names and
+                    isinstance(glbl.get(node.func.id), numpy.ufunc)) or \
+                    node.keywords or getattr(node, 'starargs', None) or \
+                    getattr(node, 'kwargs', None):
+                return None
+        elif isinstance(node, ast.Name):
+            if node.id in src_field_names:
+                fields.add(node.id)
+            elif not isinstance(glbl.get(node.id),
+                                (numpy.ufunc,) + _number_types):
+                return None
+        else:
+            return None
+    return fields
+
 class FieldExpr:
-    def __init__(self, dst_field_expr, src_field_names, fnname):
+    def __init__(self, dst_field_names, dst_field_expr, src_field_names,
+                 fnname):
         if fnname is None:
             self.__name__ = 'computed_field_expr'
         else:
             self.__name__ = fnname
+        self.dst_field_names = dst_field_names
         self.dst_field_expr = dst_field_expr
         self.src_field_names = src_field_names
         # Create a globals dict containing numpy and scipy
         # for the expressions to use
         import datetime
-        import numpy
         import scipy
         self.glbl = {}
         self.glbl.update(datetime.__dict__)
@@ -25,7 +86,68 @@ class FieldExpr:
         self.glbl['as_py'] = as_py
         self.glbl['as_numpy'] = as_numpy
 
+        # Compile the expressions once, and find those which can be
+        # evaluated a whole column at a time
+        self.dst_field_code = []
+        self.dst_field_columns = []
+        for expr in dst_field_expr:
+            try:
+                self.dst_field_code.append(
+                        compile(expr, '<computed field>', 'eval'))
+            except TypeError:
+                # Already a code object
+                self.dst_field_code.append(expr)
+            self.dst_field_columns.append(
+                    _column_expr_fields(expr, src_field_names, self.glbl))
+
+    def _load_columns(self, src, names, columns):
+        # Views the fields as NumPy columns, returning False if one
+        # of them is not a floating point column. Integer and bool
+        # columns are left to the row path, where Python ints don't
+        # wrap around and bools add up like ints.
+        for name in names:
+            if name not in columns:
+                try:
+                    col = as_numpy(getattr(src, name), allow_copy=True)
+                except TypeError:
+                    return False
+                if col.ndim != ndim_of(src) or col.dtype.kind not in 'fc':
+                    return False
+                columns[name] = col
+        return True
+
     def __call__(self, dst, src):
+        # Evaluate the fields which support it over whole columns.
+        # Fields copied unchanged are assigned within dynd, so they
+        # work for any type.
+        columns = {}
+        row_fields = []
+        for i, expr in enumerate(self.dst_field_expr):
+            names = self.dst_field_columns[i]
+            if names is None:
+                row_fields.append(i)
+            elif expr in self.src_field_names:
+                getattr(dst, self.dst_field_names[i])[:] = getattr(src, expr)
+            elif self._load_columns(src, names, columns):
+                # Python raises on a zero division or an overflow where
+                # NumPy would only warn, so those columns are redone
+                # one row at a time to raise the same errors
+                try:
+                    with numpy.errstate(all='raise'):
+                        v = eval(self.dst_field_code[i], self.glbl, columns)
+                except ArithmeticError:
+                    row_fields.append(i)
+                else:
+                    getattr(dst, self.dst_field_names[i])[:] = v
+            else:
+                row_fields.append(i)
+        # The columns view the data of src, which
+        # may not be held onto after returning
+        columns = None
+        if row_fields:
+            self._eval_rows(dst, src, row_fields)
+
+    def _eval_rows(self, dst, src, row_fields):
         # Loop element by element
         for dst_itm, src_itm in zip(dst, src):
             # Put all the src fields in a locals dict
@@ -44,9 +166,9 @@ class FieldExpr:
 
                 lcl[str(name)] = s
 
-            # Evaluate all the field exprs
-            for i, expr in enumerate(self.dst_field_expr):
-                v = eval(expr, self.glbl, lcl)
+            # Evaluate the remaining field exprs
+            for i in row_fields:
+                v = eval(self.dst_field_code[i], self.glbl, lcl)
                 dst_itm[i] = v
 
 def add_computed_fields(n, fields, rm_fields=[], fnname=None):
@@ -57,7 +179,9 @@ def add_computed_fields(n, fields, rm_fields=[], fnname=None):
     Each field_expr should be a string or bit of code
     that can be evaluated with an 'eval' call. It is called
     with numpy/scipy in the globals, and the input
-    fields in the locals.
+    fields in the locals. Expressions using only arithmetic,
+    single comparisons and NumPy ufuncs on floating point fields
+    are evaluated a whole column at a time, others once per element.
 
     Parameters
     ----------
@@ -122,7 +246,8 @@ def add_computed_fields(n, fields, rm_fields=[], fnname=None):
         new_field_expr.append(fe)
 
     result_udt = make_struct(new_field_types, new_field_names)
-    fieldexpr = FieldExpr(new_field_expr, field_names, fnname)
+    fieldexpr = FieldExpr(new_field_names, new_field_expr, field_names,
+                          fnname)
 
     return elwise_map([n], fieldexpr, result_udt)
 
@@ -136,7 +261,9 @@ def make_computed_fields(n, replace_ndim, fields, fnname=None):
     Each field_expr should be a string or bit of code
     that can be evaluated with an 'eval' call. It is called
     with numpy/scipy in the globals, and the input
-    fields in the locals.
+    fields in the locals. Expressions using only arithmetic,
+    single comparisons and NumPy ufuncs on floating point fields
+    are evaluated a whole column at a time, others once per element.
 
     Parameters
     ----------
@@ -199,6 +326,7 @@ def make_computed_fields(n, replace_ndim, fields, fnname=None):
 
     result_udt = make_struct(new_field_types, new_field_names)
     src_udt = extract_dtype(type_of(n), replace_ndim)
-    fieldexpr = FieldExpr(new_field_expr, field_names, fnname)
+    fieldexpr = FieldExpr(new_field_names, new_field_expr, field_names,
+                          fnname)
 
     return elwise_map([n], fieldexpr, result_udt, [src_udt])
@@ -3,6 +3,51 @@ import atexit, distutils, distutils.core, imp, os, os.path, shutil, sys, tempfil
 from dynd import get_include
 import dynd
 
+def apply(func, proto = None):
+  """
+  Makes an arrfunc from a function. A ctypes function pointer with a
+  scalar signature, such as a function from a ctypes.CDLL with its
+  argtypes and restype set, is called directly from the ckernel, with
+  no Python call per element. Otherwise ``func``
+  is a Python callable, called with the arguments as dynd arrays, and
+  ``proto`` gives its prototype.
+  """
+
+  import ctypes
+  if isinstance(func, ctypes._CFuncPtr):
+    if proto is not None:
+      raise ValueError('the prototype of a ctypes function comes from its '
+                       'argtypes and restype')
+    return dynd._pydynd._arrfunc_from_cfunc(func)
+  return dynd.nd.arrfunc(func, proto)
+
+def apply_strided(func, proto):
+  """
+  Makes an arrfunc from a C function with the signature of the strided
+  loop of a ckernel,
+
+      void f(char *dst, intptr_t dst_stride, char **src,
+             intptr_t *src_stride, size_t count);
+
+  which is called directly with each strided run of elements, so a
+  kernel compiled outside of dynd, such as a hand-tuned SIMD loop, runs
+  as fast as a builtin one. It must not touch Python objects, as long
+  loops run with the GIL released. The types in ``proto`` must not need
+  arrmeta, since the function receives none.
+
+  ``func`` is either a ctypes function pointer, or the address of the
+  function as an int, for example ``int(ffi.cast('uintptr_t', f))`` for
+  a cffi function. The caller keeps the library holding an address
+  loaded.
+  """
+
+  import ctypes
+  if isinstance(func, ctypes._CFuncPtr):
+    address = ctypes.cast(func, ctypes.c_void_p).value
+  else:
+    address = func
+  return dynd._pydynd._arrfunc_from_strided_cfunc(address, func, proto)
+
 def inline(statement, header = ''):
   source = '''
     #include <dynd/func/apply.hpp>
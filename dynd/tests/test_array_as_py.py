@@ -46,3 +46,39 @@ class TestArrayAsPy(unittest.TestCase):
             """)
         a = nd.array(data, type=tp)
         self.assertEqual(nd.as_py(a), data)
+
+    def test_dedupe_strings(self):
+        codes = [u'US', u'CA', u'MX', u'US', u'CA', u'US']
+        a = nd.array(codes, type='6 * string')
+        b = nd.as_py(a, dedupe=True)
+        self.assertEqual(b, codes)
+        self.assertTrue(b[0] is b[3])
+        self.assertTrue(b[0] is b[5])
+        self.assertTrue(b[1] is b[4])
+        self.assertFalse(b[0] is b[1])
+        # Also across the fields of a struct, and with fixed strings
+        a = nd.array([[u'open', u'closed'], [u'closed', u'open']],
+                     type='2 * {a: string, b: fixedstring[8]}')
+        b = nd.as_py(a, dedupe=True)
+        self.assertEqual(b, [{'a': u'open', 'b': u'closed'},
+                             {'a': u'closed', 'b': u'open'}])
+        self.assertTrue(b[0]['a'] is b[1]['b'])
+
+    def test_dedupe_non_ascii(self):
+        vals = [u'caf\xe9', u'\u65e5\u672c', u'caf\xe9', u'', u'']
+        for tp in ['5 * string', "5 * string['utf16']",
+                   "5 * fixedstring[8, 'utf32']"]:
+            a = nd.array(vals, type=tp)
+            self.assertEqual(nd.as_py(a), vals)
+            b = nd.as_py(a, dedupe=True)
+            self.assertEqual(b, vals)
+            self.assertTrue(b[0] is b[2])
+
+    def test_ascii_strings(self):
+        # Long enough to take the eight bytes at a time check
+        vals = [u'abcdefghijklmnopqrstuvwxyz', u'abcdefghijklmnopq\xe9stuvw',
+                u'0123456789abcdef\u20ac']
+        a = nd.array(vals)
+        self.assertEqual(nd.as_py(a), vals)
+        a = nd.array([u'abcdefgh' * 4, u'x'], type="2 * string['ascii']")
+        self.assertEqual(nd.as_py(a), [u'abcdefgh' * 4, u'x'])
@@ -480,6 +480,49 @@ class TestStringConstruct(unittest.TestCase):
         self.assertEqual(nd.type_of(a), ndt.type('4 * string["U16"]'))
         self.assertEqual(nd.as_py(a), ['this', 'is', 'a', 'test'])
 
+    def test_mixed_ascii_unicode_array(self):
+        # ASCII and non-ASCII strings in one batch, including empty ones
+        vals = [u'abc', u'', u'caf\xe9', u'x' * 100, u'', u'\u65e5\u672c',
+                u'plain'] * 50
+        a = nd.array(vals, dtype=ndt.string)
+        self.assertEqual(nd.as_py(a), vals)
+        a = nd.array(vals, dtype='string["U16"]')
+        self.assertEqual(nd.as_py(a), vals)
+        # An ASCII destination only takes ASCII strings
+        a = nd.array([u'abc', u'de'], dtype='string["A"]')
+        self.assertEqual(nd.as_py(a), [u'abc', u'de'])
+        self.assertRaises(Exception, nd.array, [u'abc', u'caf\xe9'],
+                          dtype='string["A"]')
+
+    def test_string_array_assign(self):
+        a = nd.empty('5 * string')
+        a[...] = [u'one', u'two', u'three', u'f\xf6ur', u'']
+        self.assertEqual(nd.as_py(a), [u'one', u'two', u'three', u'f\xf6ur', u''])
+        # Strided destination
+        a[::2] = [u'x', u'y', u'z']
+        self.assertEqual(nd.as_py(a), [u'x', u'two', u'y', u'f\xf6ur', u'z'])
+
+    def test_deduced_string_array(self):
+        vals = [u'abc', u'', u'caf\xe9', u'\u65e5\u672c', u'\U0001f600',
+                u'x' * 1000]
+        a = nd.array(vals)
+        self.assertEqual(nd.type_of(a), ndt.type('6 * string'))
+        self.assertEqual(nd.as_py(a), vals)
+        # Nested and ragged lists share one string arena
+        vals = [[u'a', u'bc'], [u'd\xe9f'], [], [u'', u'ghij', u'k']]
+        a = nd.array(vals)
+        self.assertEqual(nd.type_of(a), ndt.type('4 * var * string'))
+        self.assertEqual(nd.as_py(a), vals)
+        vals = [[u'a', u'bc'], [u'd\xe9f', u'']]
+        a = nd.array(vals)
+        self.assertEqual(nd.type_of(a), ndt.type('2 * 2 * string'))
+        self.assertEqual(nd.as_py(a), vals)
+
+    def test_deduced_string_surrogate(self):
+        if sys.version_info >= (3, 3):
+            self.assertRaises(UnicodeEncodeError, nd.array,
+                              [u'abc', u'a\ud800b'])
+
     def test_fixed_string_array(self):
         a = nd.array(['a', 'b', 'c'],
                         dtype='fixed_string[1,"A"]')
@@ -740,6 +783,57 @@ class TestIteratorConstruct(unittest.TestCase):
         self.assertRaises(TypeError, nd.array, iter([3.25j, 2, u"test"]))
         self.assertRaises(TypeError, nd.array, iter([3.25j, 2, b"test"]))
 
+    def test_dynamic_fromiter_latepromo(self):
+        # Promotions after many values have been converted
+        a = nd.array(x if x < 1000 else x + 0.5 for x in range(2000))
+        self.assertEqual(nd.type_of(a), ndt.type('2000 * float64'))
+        self.assertEqual(nd.as_py(a),
+                         [x if x < 1000 else x + 0.5 for x in range(2000)])
+        a = nd.array(x == 0 if x < 100 else x for x in range(200))
+        self.assertEqual(nd.type_of(a), ndt.type('200 * int32'))
+        self.assertEqual(nd.as_py(a),
+                         [int(x == 0) if x < 100 else x for x in range(200)])
+        # Several promotions in one iterator
+        vals = [True] * 50 + [1] * 50 + [10000000000] * 50 + [2.5] * 50 + [1j]
+        a = nd.array(iter(vals))
+        self.assertEqual(nd.type_of(a), ndt.type('201 * complex[float64]'))
+        self.assertEqual(nd.as_py(a), vals)
+
+    def test_dynamic_fromiter_nested(self):
+        # An iterator of sequences still produces a multi-dimensional array
+        a = nd.array([x, 2 * x] for x in range(5))
+        self.assertEqual(nd.type_of(a), ndt.type('5 * 2 * int32'))
+        self.assertEqual(nd.as_py(a), [[x, 2 * x] for x in range(5)])
+        a = nd.array(list(range(x)) for x in range(4))
+        self.assertEqual(nd.type_of(a), ndt.type('4 * var * int32'))
+        self.assertEqual(nd.as_py(a), [list(range(x)) for x in range(4)])
+
+    def test_dynamic_iterable_iter_once(self):
+        # An iterable whose __iter__ hands out one shared iterator
+        class Shared(object):
+            def __init__(self, vals):
+                self.it = iter(vals)
+                self.calls = 0
+            def __iter__(self):
+                self.calls += 1
+                return self.it
+        vals = Shared([[1, 2], [3, 4]])
+        a = nd.array(vals)
+        self.assertEqual(nd.as_py(a), [[1, 2], [3, 4]])
+        self.assertEqual(vals.calls, 1)
+
+    def test_dynamic_fromiter_stats(self):
+        from dynd._pydynd import _array_from_py_dynamic_stats
+        _array_from_py_dynamic_stats(reset=True)
+        nd.array(x if x < 1000 else x + 0.5 for x in range(2000))
+        stats = _array_from_py_dynamic_stats(reset=True)
+        self.assertEqual(stats['dtype_promotions'], 1)
+        self.assertEqual(stats['dim_promotions'], 0)
+        # The converted values are copied into the result once
+        self.assertEqual(stats['bytes_copied'], 2000 * 8)
+        stats = _array_from_py_dynamic_stats()
+        self.assertEqual(stats['dtype_promotions'], 0)
+
     def test_simple_fromiter(self):
         # Var dimension construction from a generator
         a = nd.array((2*x + 5 for x in range(10)), type='var * int32')
@@ -768,6 +862,43 @@ class TestIteratorConstruct(unittest.TestCase):
         self.assertEqual(len(a), 100000)
         self.assertEqual(nd.as_py(a), [2*x + 5 for x in range(100000)])
 
+    def test_fromiter_streaming(self):
+        # Generators are converted as they produce values
+        a = nd.array((str(x) for x in range(1000)), type='var * string')
+        self.assertEqual(nd.type_of(a), ndt.type('var * string'))
+        self.assertEqual(nd.as_py(a), [str(x) for x in range(1000)])
+        a = nd.array((x for x in range(1000)), type='1000 * float64')
+        self.assertEqual(nd.as_py(a), [float(x) for x in range(1000)])
+        # A single value broadcasts like a sequence of length one
+        a = nd.array((x for x in [3]), type='4 * int32')
+        self.assertEqual(nd.as_py(a), [3, 3, 3, 3])
+        # Errors raised by the generator propagate
+        def gen():
+            yield 1
+            raise ValueError('from the generator')
+        self.assertRaises(ValueError, nd.array, gen(), type='var * int32')
+        self.assertRaises(ValueError, nd.array, gen(), type='2 * int32')
+
+    def test_nd_fromiter(self):
+        a = nd.fromiter((2*x for x in range(100)), ndt.int32)
+        self.assertEqual(nd.type_of(a), ndt.type('var * int32'))
+        self.assertEqual(nd.as_py(a), [2*x for x in range(100)])
+        # Any iterable works
+        a = nd.fromiter([1.5, 2.5], ndt.float64)
+        self.assertEqual(nd.type_of(a), ndt.type('var * float64'))
+        self.assertEqual(nd.as_py(a), [1.5, 2.5])
+        a = nd.fromiter((x for x in []), ndt.int32)
+        self.assertEqual(nd.as_py(a), [])
+        # With a count, the result is a fixed dimension of that size,
+        # taking just the first values
+        it = iter(range(10))
+        a = nd.fromiter(it, ndt.int64, count=4)
+        self.assertEqual(nd.type_of(a), ndt.type('4 * int64'))
+        self.assertEqual(nd.as_py(a), [0, 1, 2, 3])
+        self.assertEqual(next(it), 4)
+        self.assertRaises(nd.BroadcastError, nd.fromiter,
+                          (x for x in range(3)), ndt.int32, count=4)
+
     def test_ragged_fromiter(self):
         # Strided array of var from list of iterators
         a = nd.array([(1+x for x in range(3)), (5*x - 10 for x in range(5)),
@@ -923,6 +1054,47 @@ class TestDeduceDims(unittest.TestCase):
         self.assertEqual(nd.type_of(a), ndt.type('var * int32'))
         self.assertEqual(nd.as_py(a), [])
 
+    def test_flat_scalars(self):
+        # A flat list or tuple of scalars with a scalar dtype
+        a = nd.array([1.5, 2, 3.25], dtype=ndt.float64)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(a), [1.5, 2, 3.25])
+        a = nd.array((1, 2, 3), dtype=ndt.int8)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * int8'))
+        self.assertEqual(nd.as_py(a), [1, 2, 3])
+        a = nd.array([u'abc', u'de'], dtype=ndt.string)
+        self.assertEqual(nd.type_of(a), ndt.type('2 * string'))
+        self.assertEqual(nd.as_py(a), [u'abc', u'de'])
+        a = nd.array([1, None, 3], dtype='?int32')
+        self.assertEqual(nd.type_of(a), ndt.type('3 * ?int32'))
+        self.assertEqual(nd.as_py(a), [1, None, 3])
+        a = nd.array([1, 2], dtype=ndt.int32, access='rw')
+        self.assertEqual(a.access_flags, 'readwrite')
+        a = nd.array([1, 2], dtype=ndt.int32, access='r')
+        self.assertEqual(a.access_flags, 'immutable')
+
+    def test_flat_scalars_mismatch(self):
+        # A later element which isn't a scalar gets the same
+        # errors as when every element is checked up front
+        self.assertRaises(RuntimeError, nd.array, [1, [2, 3]],
+                          dtype=ndt.int32)
+        self.assertRaises(OverflowError, nd.array, [1, 2, 1000],
+                          dtype=ndt.int8)
+
+    def test_flat_scalars_error_raised_once(self):
+        # Errors other than a mismatch are raised from the first
+        # conversion, without converting the elements again
+        class Interrupted(Exception):
+            pass
+        calls = []
+        class Value(object):
+            def __float__(self):
+                calls.append(1)
+                raise Interrupted()
+        self.assertRaises(Interrupted, nd.array, [1.5, Value()],
+                          dtype=ndt.float64)
+        self.assertEqual(len(calls), 1)
+
 class TestConstructErrors(unittest.TestCase):
     def test_bad_params(self):
         self.assertRaises(ValueError, nd.array, dtype='int32')
@@ -30,6 +30,102 @@ class TestArrFunc(unittest.TestCase):
         a = af(1, 10)
         self.assertEqual(nd.as_py(a), {'x': 1, 'y': 10})
 
+    def test_arrfunc_scalar_calls(self):
+        # Builtin signatures take a fast path for scalar arguments,
+        # results must be the same as through the general path
+        af = nd.arrfunc(lambda x, y: x * y, '(int32, float64) -> float64')
+        for i in range(100):
+            a = af(i, 0.5)
+            self.assertEqual(nd.type_of(a), ndt.float64)
+            self.assertEqual(nd.as_py(a), i * 0.5)
+        self.assertEqual(nd.as_py(af(nd.array(3, type=ndt.int32), 2)), 6.0)
+        # An int converts to a float parameter
+        self.assertEqual(nd.as_py(af(4, 3)), 12.0)
+        # Out of range values still raise
+        self.assertRaises(OverflowError, af, 2**40, 1.0)
+
+    def test_arrfunc_ckernel_cache(self):
+        af = nd.arrfunc(lambda x, y: x * y, '(int32, float64) -> float64')
+        info = af.ckernel_cache_info
+        self.assertEqual(info['size'], 0)
+        self.assertEqual(info['capacity'], af.ckernel_cache_capacity)
+        # The first call instantiates, later calls reuse the ckernel
+        for i in range(10):
+            self.assertEqual(nd.as_py(af(i, 2.0)), i * 2.0)
+        info = af.ckernel_cache_info
+        self.assertEqual(info['misses'], 1)
+        self.assertEqual(info['hits'], 9)
+        self.assertEqual(info['size'], 1)
+        # Clearing drops the ckernel and resets the counters
+        af.clear_ckernel_cache()
+        info = af.ckernel_cache_info
+        self.assertEqual((info['hits'], info['misses'], info['size']),
+                         (0, 0, 0))
+        # A capacity of 0 disables the cache, results are unchanged
+        af.ckernel_cache_capacity = 0
+        self.assertEqual(nd.as_py(af(3, 2.0)), 6.0)
+        info = af.ckernel_cache_info
+        self.assertEqual((info['hits'], info['size'], info['capacity']),
+                         (0, 0, 0))
+        af.ckernel_cache_capacity = 1
+        self.assertEqual(nd.as_py(af(3, 2.0)), 6.0)
+        self.assertEqual(af.ckernel_cache_info['size'], 1)
+
+    def test_arrfunc_ckernel_cache_arrays(self):
+        # Array arguments of the exact concrete types are cached too
+        af = nd.arrfunc(lambda x: x, '(3 * int32) -> 3 * int32')
+        a = nd.array([1, 2, 3], type='3 * int32')
+        self.assertEqual(nd.as_py(af(a)), [1, 2, 3])
+        self.assertEqual(nd.as_py(af(a)), [1, 2, 3])
+        info = af.ckernel_cache_info
+        self.assertEqual(info['misses'], 1)
+        self.assertEqual(info['hits'], 1)
+        # The cached ckernel outlives the arrays it was made with
+        del a
+        for i in range(10):
+            b = nd.array([i, i + 1, i + 2], type='3 * int32')
+            self.assertEqual(nd.as_py(af(b)), [i, i + 1, i + 2])
+        self.assertEqual(af.ckernel_cache_info['misses'], 1)
+
+    def test_native_ckernel_builder(self):
+        self.assertEqual(_lowlevel.CKernelBuilder.__module__,
+                         'dynd._pydynd')
+        i64 = (ctypes.c_int64 * 3)(3, 7, 21)
+        f32 = (ctypes.c_float * 3)()
+        # Build and call a single kernel
+        with _lowlevel.CKernelBuilder() as ckb:
+            _lowlevel.make_assignment_ckernel(ckb, 0, ndt.float32, None,
+                                              ndt.int64, None, "single")
+            ck = ckb.ckernel(_lowlevel.ExprSingleOperation)
+            src = (ctypes.c_void_p * 1)(ctypes.addressof(i64))
+            ck(ctypes.addressof(f32), src)
+            self.assertEqual(f32[0], 3)
+            # Arguments like ctypes.byref() go through ctypes
+            i64[0] = 5
+            ck(ctypes.byref(f32), src)
+            self.assertEqual(f32[0], 5)
+            i64[0] = 3
+            # Reuse the builder for a strided kernel
+            ckb.reset()
+            _lowlevel.make_assignment_ckernel(ckb, 0, ndt.float32, None,
+                                              ndt.int64, None, "strided")
+            ck = ckb.ckernel(_lowlevel.ExprStridedOperation)
+            src_stride = (c_ssize_t * 1)(8)
+            ck(ctypes.addressof(f32), 4, src, src_stride, 3)
+            self.assertEqual(list(f32), [3, 7, 21])
+            # ctypes rejects a byte array for the POINTER(c_ssize_t)
+            # stride, so this only works when called natively
+            f32[:] = [0, 0, 0]
+            raw_stride = (ctypes.c_uint8 * ctypes.sizeof(c_ssize_t))()
+            c_ssize_t.from_buffer(raw_stride).value = 8
+            ck(f32, 4, src, raw_stride, 3)
+            self.assertEqual(list(f32), [3, 7, 21])
+            # Arguments which are not pointers are rejected by ctypes
+            self.assertRaises(ctypes.ArgumentError,
+                              ck, 1.5, 4, src, src_stride, 3)
+        # A closed builder can't be used
+        self.assertRaises(ValueError, ckb.reset)
+
     """
     def test_assignment_arrfunc(self):
         af = _lowlevel.make_arrfunc_from_assignment(
@@ -85,6 +181,29 @@ class TestArrFunc(unittest.TestCase):
     def test_from_numpy_int32_add_withgil(self):
         self.check_from_numpy_int32_add(True)
 
+    def check_from_numpy_strided_add(self, requiregil):
+        af = _lowlevel.arrfunc_from_ufunc(np.add,
+                        (np.float64, np.float64, np.float64),
+                        requiregil)
+        af_lift = _lowlevel.lift_arrfunc(af)
+        # Large enough to release the GIL and to need several
+        # buffered blocks, with strided inputs and a broadcast one
+        x = np.arange(30000, dtype=np.float64)
+        y = np.arange(60000, dtype=np.float64)[::-2]
+        a = af_lift(nd.view(x[::3]), nd.view(y[::2]))
+        self.assertEqual(nd.as_py(a), (x[::3] + y[::2]).tolist())
+        a = af_lift(nd.view(x[::3]), 1.5)
+        self.assertEqual(nd.as_py(a), (x[::3] + 1.5).tolist())
+        x2 = x.reshape(100, 300)
+        a = af_lift(nd.view(x2.T), nd.view(x2.T))
+        self.assertEqual(nd.as_py(a), (x2.T + x2.T).tolist())
+
+    def test_from_numpy_strided_add_nogil(self):
+        self.check_from_numpy_strided_add(False)
+
+    def test_from_numpy_strided_add_withgil(self):
+        self.check_from_numpy_strided_add(True)
+
     def test_lift_arrfunc(self):
         # First get a ckernel from numpy
         requiregil = False
@@ -135,6 +254,63 @@ class TestArrFunc(unittest.TestCase):
                           (0.5 + 3.0 + 2.5) / 2.0,
                           5.0])
 
+    def test_arrfunc_from_cfunc(self):
+        import ctypes.util
+        from dynd.nd.functional import apply
+        libm_name = ctypes.util.find_library('m')
+        if libm_name is None:
+            self.skipTest('libm not found')
+        libm = ctypes.CDLL(libm_name)
+        pow = libm.pow
+        pow.argtypes = [ctypes.c_double, ctypes.c_double]
+        pow.restype = ctypes.c_double
+        af = apply(pow)
+        self.assertEqual(nd.type_of(af),
+                         ndt.type('(float64, float64) -> float64'))
+        self.assertEqual(nd.as_py(af(2.0, 10.0)), 1024.0)
+        # Lifted over arrays, with the C function called per element
+        af_lifted = _lowlevel.lift_arrfunc(af)
+        out = af_lifted(nd.array([1.0, 2.0, 3.0] * 2000),
+                        nd.array([2.0] * 6000))
+        self.assertEqual(nd.as_py(out), [1.0, 4.0, 9.0] * 2000)
+        # Signatures mixing types are not supported natively
+        ldexp = libm.ldexp
+        ldexp.argtypes = [ctypes.c_double, ctypes.c_int]
+        ldexp.restype = ctypes.c_double
+        self.assertRaises(TypeError, apply, ldexp)
+
+    def test_arrfunc_from_strided_cfunc(self):
+        from dynd.nd.functional import apply_strided
+        STRIDED = ctypes.CFUNCTYPE(None, ctypes.c_void_p, c_ssize_t,
+                                   ctypes.POINTER(ctypes.c_void_p),
+                                   ctypes.POINTER(c_ssize_t), ctypes.c_size_t)
+        calls = []
+        def add(dst, dst_stride, src, src_stride, count):
+            calls.append(count)
+            for i in range(count):
+                x = ctypes.c_int32.from_address(src[0] + i * src_stride[0])
+                y = ctypes.c_int32.from_address(src[1] + i * src_stride[1])
+                out = ctypes.c_int32.from_address(dst + i * dst_stride)
+                out.value = x.value + y.value
+        cadd = STRIDED(add)
+        af = apply_strided(cadd, '(int32, int32) -> int32')
+        self.assertEqual(nd.type_of(af), ndt.type('(int32, int32) -> int32'))
+        self.assertEqual(nd.as_py(af(3, 4)), 7)
+        # One call for a whole strided run of elements
+        af_lifted = _lowlevel.lift_arrfunc(af)
+        del calls[:]
+        out = af_lifted(nd.array(list(range(10)), type='10 * int32'),
+                        nd.array([100] * 10, type='10 * int32'))
+        self.assertEqual(nd.as_py(out), [100 + x for x in range(10)])
+        self.assertEqual(calls, [10])
+        # By raw address
+        address = ctypes.cast(cadd, ctypes.c_void_p).value
+        af = apply_strided(address, '(int32, int32) -> int32')
+        self.assertEqual(nd.as_py(af(5, 6)), 11)
+        # Types needing arrmeta can't be passed to a C function
+        self.assertRaises(TypeError, apply_strided, cadd,
+                          '(var * int32, int32) -> int32')
+
 class TestLiftReductionArrFunc(unittest.TestCase):
     def test_sum_1d(self):
         # Use the numpy add ufunc for this lifting test
@@ -51,6 +51,54 @@ if sys.version_info[:2] > (2, 6):
             self.assertEqual(nd.as_py(b.complex), [1+2j, -1+1j, 2+5j])
         """
 
+        @unittest.skipIf(scipy is None, "scipy is not installed")
+        def test_column_exprs(self):
+            a = nd.array([(2, 0, 'a'), (0, -2, 'b'), (3, 4, 'c')],
+                    dtype='{x: float64, y: float64, name: string}')
+            b = nd.add_computed_fields(a,
+                    fields=[('r', ndt.float64, 'sqrt(x*x + y*y)'),
+                            ('pos', ndt.bool, 'y > 0'),
+                            ('sgn', ndt.float64, 'x if y >= 0 else -x')],
+                    rm_fields=['y'])
+            self.assertEqual(nd.as_py(b.name), ['a', 'b', 'c'])
+            self.assertEqual(nd.as_py(b.x), [2, 0, 3])
+            self.assertEqual(nd.as_py(b.r), [2, 2, 5])
+            self.assertEqual(nd.as_py(b.pos), [False, False, True])
+            # A conditional expression is evaluated one row at a time
+            self.assertEqual(nd.as_py(b.sgn), [2, 0, 3])
+
+        @unittest.skipIf(scipy is None, "scipy is not installed")
+        def test_column_int_overflow(self):
+            # Integer fields are evaluated as Python ints, so a product
+            # does not wrap around at the width of the source field
+            a = nd.array([(100000,), (-3,)], dtype='{a: int32}')
+            b = nd.add_computed_fields(a, fields=[('sq', ndt.int64, 'a * a')])
+            self.assertEqual(nd.as_py(b.sq), [10000000000, 9])
+            b = nd.add_computed_fields(a, fields=[('r', ndt.float64, 'a ** -1')])
+            self.assertEqual(nd.as_py(b.r), [1e-5, -1.0 / 3])
+
+        @unittest.skipIf(scipy is None, "scipy is not installed")
+        def test_column_zero_division(self):
+            a = nd.array([(1.0, 2.0), (3.0, 0.0)], dtype='{x: float64, y: float64}')
+            b = nd.add_computed_fields(a, fields=[('q', ndt.float64, 'x / y')])
+            self.assertRaises(ZeroDivisionError, b.eval)
+            a = nd.array([(1, 2), (3, 0)], dtype='{x: int32, y: int32}')
+            b = nd.add_computed_fields(a, fields=[('q', ndt.int32, 'x // y')])
+            self.assertRaises(ZeroDivisionError, b.eval)
+
+        def test_column_expr_fields(self):
+            from dynd.nd.computed_fields import _column_expr_fields
+            glbl = np.__dict__
+            self.assertEqual(_column_expr_fields('arctan2(y, x) * 2',
+                                                 ['x', 'y'], glbl),
+                             set(['x', 'y']))
+            self.assertEqual(_column_expr_fields('x < y', ['x', 'y'], glbl),
+                             set(['x', 'y']))
+            for expr in ['0 < x < y', 'x if y else 0', 'sum(x)', 'z + 1',
+                         'sqrt(x=1)', '"text"', 'x.real']:
+                self.assertEqual(_column_expr_fields(expr, ['x', 'y'], glbl),
+                                 None)
+
         @unittest.skipIf(scipy is None, "scipy is not installed")
         def test_aggregate(self):
             a = nd.array([
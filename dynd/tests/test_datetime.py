@@ -1,7 +1,7 @@
 import sys
 import unittest
 import ctypes
-from datetime import date, time
+from datetime import date, time, datetime, timedelta, tzinfo
 from dynd import nd, ndt
 
 class TestDate(unittest.TestCase):
@@ -163,5 +163,134 @@ class TestTime(unittest.TestCase):
         self.assertEqual(nd.as_py(s.tick), 7654320)
 
 
+class FixedOffset(tzinfo):
+    def __init__(self, minutes):
+        self.offset = timedelta(minutes=minutes)
+    def utcoffset(self, dt):
+        return self.offset
+    def dst(self, dt):
+        return timedelta(0)
+
+class TestDatetimeFromPy(unittest.TestCase):
+    def test_date_batch(self):
+        lst = [date(1, 1, 1), date(1969, 12, 31), date(1970, 1, 1),
+               date(2000, 2, 29), date(9999, 12, 31)] * 100
+        a = nd.array(lst, type='%d * date' % len(lst))
+        self.assertEqual(nd.as_py(a), lst)
+        # Midnight datetimes convert to dates, others raise
+        a = nd.array([datetime(2001, 5, 6), date(2002, 7, 8)],
+                     type='2 * date')
+        self.assertEqual(nd.as_py(a), [date(2001, 5, 6), date(2002, 7, 8)])
+        self.assertRaises(ValueError, nd.array,
+                          [datetime(2001, 5, 6, 12)], type='1 * date')
+
+    def test_datetime_batch(self):
+        lst = [datetime(1, 1, 1), datetime(1969, 12, 31, 23, 59, 59, 999999),
+               datetime(1970, 1, 1), datetime(2000, 2, 29, 12, 30, 15, 5),
+               datetime(9999, 12, 31, 23, 59, 59, 999999)] * 100
+        a = nd.array(lst, type='%d * datetime' % len(lst))
+        self.assertEqual(nd.as_py(a), lst)
+        # Mixed in strings go through the general conversion
+        a = nd.array([datetime(2000, 1, 2, 3), '2001-02-03T04:05'],
+                     type='2 * datetime')
+        self.assertEqual(nd.as_py(a), [datetime(2000, 1, 2, 3),
+                                       datetime(2001, 2, 3, 4, 5)])
+
+    def test_aware_datetime(self):
+        # Aware datetimes are stored in UTC
+        tz = FixedOffset(-90)
+        lst = [datetime(2000, 1, 1, 22, 45, tzinfo=tz),
+               datetime(2000, 1, 1, 12, tzinfo=FixedOffset(60))]
+        a = nd.array(lst, type='2 * datetime')
+        self.assertEqual(nd.as_py(a), [datetime(2000, 1, 2, 0, 15),
+                                       datetime(2000, 1, 1, 11)])
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.type("datetime[tz='UTC']"))
+        a = nd.array(datetime(2000, 1, 1, tzinfo=tz))
+        self.assertEqual(nd.type_of(a), ndt.type("datetime[tz='UTC']"))
+        self.assertEqual(nd.as_py(a.hour), 1)
+        self.assertEqual(nd.as_py(a.minute), 30)
+
+class TestDatetimeAsPy(unittest.TestCase):
+    def test_date_column(self):
+        lst = [date(1, 1, 1), date(1969, 12, 31), date(1970, 1, 1),
+               date(2000, 2, 29), date(9999, 12, 31)]
+        a = nd.array(lst * 300, type='1500 * date')
+        self.assertEqual(nd.as_py(a), lst * 300)
+        # Strided and reversed views
+        self.assertEqual(nd.as_py(a[::3]), (lst * 300)[::3])
+        self.assertEqual(nd.as_py(a[::-1]), (lst * 300)[::-1])
+
+    def test_repeated_dates_shared(self):
+        a = nd.array([date(2000, 1, 1), date(2001, 1, 1)] * 10,
+                     type='20 * date')
+        b = nd.as_py(a)
+        self.assertTrue(b[0] is b[2])
+        self.assertTrue(b[1] is b[19])
+        self.assertEqual(b[0], date(2000, 1, 1))
+
+    def test_datetime_column(self):
+        lst = [datetime(1, 1, 1), datetime(1969, 12, 31, 23, 59, 59, 999999),
+               datetime(1970, 1, 1), datetime(2000, 2, 29, 12, 30, 15, 5),
+               datetime(9999, 12, 31, 23, 59, 59, 999999)]
+        a = nd.array(lst * 300, type='1500 * datetime')
+        self.assertEqual(nd.as_py(a), lst * 300)
+        self.assertEqual(nd.as_py(a[1::7]), (lst * 300)[1::7])
+        a = nd.array(lst, type="5 * datetime[tz='UTC']")
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_struct_field(self):
+        a = nd.array([(date(2000, 1, 1), datetime(2000, 1, 1, 5)),
+                      (date(1960, 6, 30), datetime(1960, 6, 30, 1, 2, 3))],
+                     type='2 * {d: date, dt: datetime}')
+        self.assertEqual(nd.as_py(a),
+                         [{'d': date(2000, 1, 1), 'dt': datetime(2000, 1, 1, 5)},
+                          {'d': date(1960, 6, 30),
+                           'dt': datetime(1960, 6, 30, 1, 2, 3)}])
+
+class TestDatetimeParse(unittest.TestCase):
+    def test_iso_dates(self):
+        strs = ['2012-03-17', '1922-12-30', '2000-02-29', '0001-01-01',
+                '9999-12-31', '1969-12-31', '1970-01-01']
+        a = nd.array(strs).ucast(ndt.date).eval()
+        self.assertEqual(nd.as_py(a), [date(2012, 3, 17), date(1922, 12, 30),
+                                       date(2000, 2, 29), date(1, 1, 1),
+                                       date(9999, 12, 31), date(1969, 12, 31),
+                                       date(1970, 1, 1)])
+        # Other forms go through the general parser
+        a = nd.array(['2012-03-17', '01/02/03']).ucast(ndt.date).eval(
+                ectx=nd.eval_context(date_parse_order='YMD'))
+        self.assertEqual(nd.as_py(a), [date(2012, 3, 17), date(2001, 2, 3)])
+        # Including the errors it raises
+        self.assertRaises(ValueError,
+                nd.array(['2012-03-17', '2011-02-29']).ucast(ndt.date).eval)
+        self.assertRaises(ValueError,
+                nd.array(['2012-03-17', '2012-03-17T17:00']).ucast(ndt.date).eval)
+
+    def test_iso_datetimes(self):
+        strs = ['2012-03-17', '2012-03-17T17:05', '2012-03-17 17:05:31',
+                '1969-12-31T23:59:59.5', '2000-02-29T12:30:15.000005']
+        a = nd.array(strs).ucast(ndt.type('datetime')).eval()
+        self.assertEqual(nd.as_py(a), [datetime(2012, 3, 17),
+                                       datetime(2012, 3, 17, 17, 5),
+                                       datetime(2012, 3, 17, 17, 5, 31),
+                                       datetime(1969, 12, 31, 23, 59, 59, 500000),
+                                       datetime(2000, 2, 29, 12, 30, 15, 5)])
+        self.assertRaises(ValueError,
+                nd.array(['2012-03-17T24:00']).ucast(ndt.type('datetime')).eval)
+
+    def test_parallel_parse(self):
+        strs = ['%04d-%02d-%02d' % (1900 + i % 200, 1 + i % 12, 1 + i % 28)
+                for i in range(20000)]
+        strs[12345] = '04/02/03'
+        expected = [date(1900 + i % 200, 1 + i % 12, 1 + i % 28)
+                    for i in range(20000)]
+        expected[12345] = date(2004, 2, 3)
+        a = nd.array(strs).ucast(ndt.date)
+        ectx = nd.eval_context(threads=4, grainsize=1000,
+                               date_parse_order='YMD')
+        self.assertEqual(nd.as_py(a.eval(ectx=ectx)), expected)
+        self.assertEqual(nd.as_py(a.eval_copy(ectx=ectx)), expected)
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
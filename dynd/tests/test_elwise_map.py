@@ -110,5 +110,61 @@ class TestElwiseMap(unittest.TestCase):
         b[...] = 100
         self.assertEqual(nd.as_py(c), [0, -100, 1000, -200, 400])
 
+    def test_blocksize(self):
+        sizes = []
+        def doubler(dst, src):
+            sizes.append(len(src))
+            dst[...] = [2 * nd.as_py(x) for x in src]
+        a = nd.range(10)
+        b = nd.elwise_map([a], doubler, ndt.int32, blocksize=4)
+        self.assertEqual(nd.as_py(b), [2 * x for x in range(10)])
+        self.assertEqual(sizes, [4, 4, 2])
+        # Blocks of previously seen sizes reuse their types, the
+        # arrays given to the callable still have the right shape
+        del sizes[:]
+        self.assertEqual(nd.as_py(b[1:]), [2 * x for x in range(1, 10)])
+        self.assertEqual(sizes, [4, 4, 1])
+        del sizes[:]
+        self.assertEqual(nd.as_py(b[3]), 6)
+        self.assertEqual(sizes, [1])
+        # Without a block size, a call gets the whole dimension
+        del sizes[:]
+        b = nd.elwise_map([a], doubler, ndt.int32)
+        b.eval()
+        self.assertEqual(sizes, [10])
+        self.assertRaises(ValueError, nd.elwise_map, [a], doubler,
+                          ndt.int32, blocksize=0)
+
+    def test_memoize(self):
+        calls = []
+        def doubler(dst, src):
+            calls.append(len(src))
+            dst[...] = [2 * nd.as_py(x) for x in src]
+        a = nd.range(5).eval_copy(access='readwrite')
+        b = nd.memoize(nd.elwise_map([a], doubler, ndt.int32))
+        self.assertTrue(isinstance(b, nd.memoized_array))
+        # Reading part of it before evaluating computes just that part
+        self.assertEqual(nd.as_py(b[1:3]), [2, 4])
+        self.assertEqual(calls, [2])
+        # The first eval computes, later reads come from the cache
+        self.assertEqual(nd.as_py(b.eval()), [0, 2, 4, 6, 8])
+        self.assertEqual(nd.as_py(b.eval()), [0, 2, 4, 6, 8])
+        self.assertEqual(nd.as_py(b[3]), 6)
+        self.assertEqual(calls, [2, 5])
+        self.assertEqual(b.cache_info,
+                         {'hits': 2, 'misses': 2, 'cached': True})
+        # Changes to the source show after invalidating
+        a[0] = 10
+        self.assertEqual(nd.as_py(b.eval()), [0, 2, 4, 6, 8])
+        b.invalidate()
+        self.assertFalse(b.cache_info['cached'])
+        self.assertEqual(nd.as_py(b.eval()), [20, 2, 4, 6, 8])
+        self.assertEqual(calls, [2, 5, 5])
+        self.assertRaises(TypeError, b.__setitem__, 0, 1)
+        # The cached values can't be changed through eval() either
+        c = b.eval()
+        self.assertRaises(RuntimeError, c.__setitem__, 0, 99)
+        self.assertEqual(nd.as_py(b.eval()), [20, 2, 4, 6, 8])
+
 if __name__ == '__main__':
     unittest.main()
@@ -10,21 +10,52 @@ class TestEvalContext(unittest.TestCase):
         self.assertEqual(ectx.cuda_device_errmode, 'nocheck'),
         self.assertEqual(ectx.date_parse_order, 'NoAmbig')
         self.assertEqual(ectx.century_window, 70)
+        self.assertEqual(ectx.threads, 1)
+        self.assertEqual(ectx.grainsize, 16384)
 
     def test_modified_properties(self):
         ectx = nd.eval_context(errmode='overflow',
                                cuda_device_errmode='fractional',
                                date_parse_order='YMD',
-                               century_window=1929)
+                               century_window=1929,
+                               threads=4,
+                               grainsize=100)
         self.assertEqual(ectx.errmode, 'overflow')
         self.assertEqual(ectx.cuda_device_errmode, 'fractional'),
         self.assertEqual(ectx.date_parse_order, 'YMD')
         self.assertEqual(ectx.century_window, 1929)
+        self.assertEqual(ectx.threads, 4)
+        self.assertEqual(ectx.grainsize, 100)
         self.assertEqual(repr(ectx),
                          "nd.eval_context(errmode='overflow',\n" +
                          "                cuda_device_errmode='fractional',\n" +
                          "                date_parse_order='YMD',\n" +
-                         "                century_window=1929)")
+                         "                century_window=1929,\n" +
+                         "                threads=4,\n" +
+                         "                grainsize=100)")
+
+    def test_invalid_threading(self):
+        self.assertRaises(ValueError, nd.eval_context, threads=-1)
+        self.assertRaises(ValueError, nd.eval_context, grainsize=0)
+        # Zero threads means one per hardware thread
+        self.assertEqual(nd.eval_context(threads=0).threads, 0)
+
+    def test_parallel_eval(self):
+        a = nd.range(100000).ucast(ndt.float64)
+        ectx = nd.eval_context(threads=4, grainsize=100)
+        b = a.eval(ectx=ectx)
+        self.assertEqual(nd.type_of(b), ndt.type('100000 * float64'))
+        self.assertEqual(nd.as_py(b), nd.as_py(a.eval()))
+        c = a.eval_copy(ectx=ectx)
+        self.assertEqual(nd.as_py(c), nd.as_py(b))
+        # A var inner dimension allocates from the result's memory
+        # block, so it is evaluated on one thread
+        lst = [[i] * (i % 5) for i in range(1000)]
+        a = nd.array(lst, type='1000 * var * int32').ucast(ndt.float64)
+        self.assertEqual(nd.as_py(a.eval(ectx=ectx)), lst)
+        # Errors raised in a worker thread reach the caller
+        a = nd.array([1.5] * 1000).ucast(ndt.int32)
+        self.assertRaises(RuntimeError, a.eval, ectx=ectx)
 
     def test_eval_errmode(self):
         a = nd.array(1.5).cast(ndt.int32)
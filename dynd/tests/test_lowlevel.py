@@ -1,7 +1,28 @@
 import sys
 import unittest
 import ctypes
-from dynd import nd, ndt, _lowlevel
+from dynd import nd, ndt, _lowlevel, _pydynd
+
+# Mirrors pydynd_capi_t from pydynd_capi.h
+FreeOwnerFunction = ctypes.CFUNCTYPE(None, ctypes.c_void_p)
+class CAPIStruct(ctypes.Structure):
+    _fields_ = [('version', ctypes.c_uint32),
+                ('array_check',
+                 ctypes.PYFUNCTYPE(ctypes.c_int, ctypes.py_object)),
+                ('array_from_buffer',
+                 ctypes.PYFUNCTYPE(ctypes.py_object, ctypes.py_object,
+                        ctypes.c_ssize_t, ctypes.c_void_p, ctypes.c_void_p,
+                        ctypes.c_void_p, ctypes.c_void_p, FreeOwnerFunction,
+                        ctypes.c_uint32)),
+                ('array_empty',
+                 ctypes.PYFUNCTYPE(ctypes.py_object, ctypes.py_object,
+                        ctypes.c_ssize_t, ctypes.c_void_p)),
+                ('array_data',
+                 ctypes.PYFUNCTYPE(ctypes.c_void_p, ctypes.py_object)),
+                ('array_arrmeta',
+                 ctypes.PYFUNCTYPE(ctypes.c_void_p, ctypes.py_object)),
+                ('array_access_flags',
+                 ctypes.PYFUNCTYPE(ctypes.c_uint32, ctypes.py_object))]
 
 class TestLowLevel(unittest.TestCase):
     def type_id_of(self, dt):
@@ -168,5 +189,45 @@ class TestLowLevel(unittest.TestCase):
                         ndt.type('Fixed * int32'), ctypes.addressof(a),
                         a, 'readwrite')
 
+    def test_capi_capsule(self):
+        get_pointer = ctypes.pythonapi.PyCapsule_GetPointer
+        get_pointer.restype = ctypes.c_void_p
+        get_pointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+        capi = CAPIStruct.from_address(
+                        get_pointer(_pydynd._C_API, b'dynd._pydynd._C_API'))
+        self.assertTrue(capi.version >= 1)
+
+        # Wrap a buffer as its transpose, with a callback freeing it
+        buf = (ctypes.c_int32 * 6)(*range(6))
+        freed = []
+        free_owner = FreeOwnerFunction(lambda owner: freed.append(owner))
+        shape = (ctypes.c_ssize_t * 2)(2, 3)
+        strides = (ctypes.c_ssize_t * 2)(4, 8)
+        a = capi.array_from_buffer(ndt.int32, 2, ctypes.addressof(shape),
+                                   ctypes.addressof(strides),
+                                   ctypes.addressof(buf), 1234, free_owner, 1)
+        self.assertEqual(capi.array_check(a), 1)
+        self.assertEqual(capi.array_check(buf), 0)
+        self.assertEqual(nd.type_of(a), ndt.type('2 * 3 * int32'))
+        self.assertEqual(nd.as_py(a), [[0, 2, 4], [1, 3, 5]])
+        self.assertEqual(capi.array_data(a), ctypes.addressof(buf))
+        self.assertEqual(capi.array_access_flags(a), 1)
+        self.assertEqual(freed, [])
+        del a
+        self.assertEqual(freed, [1234])
+
+        # Errors are raised as Python exceptions
+        self.assertRaises(TypeError, capi.array_from_buffer,
+                          'Fixed * int32', 0, None, None,
+                          ctypes.addressof(buf), None, None, 1)
+        self.assertRaises(ValueError, capi.array_from_buffer,
+                          ndt.int32, 0, None, None,
+                          ctypes.addressof(buf), None, None, 6)
+
+        b = capi.array_empty('int16', 2, ctypes.addressof(shape))
+        self.assertEqual(nd.type_of(b), ndt.type('2 * 3 * int16'))
+        self.assertEqual(capi.array_access_flags(b), 3)
+        self.assertEqual(capi.array_data(b), _lowlevel.data_address_of(b))
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
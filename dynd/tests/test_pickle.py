@@ -1,5 +1,6 @@
 import sys
 import unittest
+import pickle
 from pickle import loads, dumps
 from dynd import nd, ndt
 
@@ -9,3 +10,59 @@ class TestPickle(unittest.TestCase):
         self.assertEqual(nd.eval_context, loads(dumps(nd.eval_context)))
         self.assertEqual(nd.arrfunc, loads(dumps(nd.arrfunc)))
         self.assertEqual(ndt.type, loads(dumps(ndt.type)))
+
+class TestPickleArray(unittest.TestCase):
+    def check_roundtrip(self, a):
+        for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+            b = loads(dumps(a, protocol=protocol))
+            self.assertEqual(nd.type_of(b), nd.type_of(a))
+            self.assertEqual(nd.as_py(b), nd.as_py(a))
+
+    def test_fixed_layout(self):
+        self.check_roundtrip(nd.array(3.25))
+        self.check_roundtrip(nd.array([1, 2, 3], type='3 * int16'))
+        self.check_roundtrip(nd.array([[1.5, 2], [3, 4]]))
+        self.check_roundtrip(nd.array([(1, 2.5), (3, 4.5)],
+                                      type='2 * {x: int8, y: float64}'))
+        # Strided views are pickled as a contiguous copy
+        self.check_roundtrip(nd.range(20)[::3])
+        self.check_roundtrip(nd.range(0))
+
+    def test_writable(self):
+        # Unpickled arrays are writable at every protocol
+        a = nd.array([1, 2, 3], type='3 * int32')
+        for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+            b = loads(dumps(a, protocol=protocol))
+            b[0] = 10
+            self.assertEqual(nd.as_py(b), [10, 2, 3])
+            self.assertEqual(nd.as_py(a), [1, 2, 3])
+
+    def test_var_and_string(self):
+        self.check_roundtrip(nd.array([[1], [2, 3], []],
+                                      type='3 * var * int32'))
+        self.check_roundtrip(nd.array(['this', 'is', 'a', 'test']))
+        self.check_roundtrip(nd.array([('x', [1, 2])],
+                                      type='1 * {a: string, b: var * int32}'))
+
+    def test_expression(self):
+        a = nd.array([1, 2, 3]).ucast(ndt.float64)
+        b = loads(dumps(a))
+        self.assertEqual(nd.type_of(b), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(b), [1.0, 2.0, 3.0])
+
+    @unittest.skipIf(pickle.HIGHEST_PROTOCOL < 5,
+                     'pickle protocol 5 is not available')
+    def test_out_of_band(self):
+        a = nd.range(1000, dtype=ndt.float64)
+        buffers = []
+        data = dumps(a, protocol=5, buffer_callback=buffers.append)
+        self.assertEqual(len(buffers), 1)
+        # The data travels out of band, not in the pickle stream
+        self.assertTrue(len(data) < 1000)
+        b = loads(data, buffers=buffers)
+        self.assertEqual(nd.as_py(b), nd.as_py(a))
+        # A writable buffer is viewed without a copy
+        raw = bytearray(buffers[0].raw())
+        b = loads(data, buffers=[raw])
+        raw[0:8] = bytearray(8)
+        self.assertEqual(nd.as_py(b[0]), 0.0)
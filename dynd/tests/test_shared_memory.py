@@ -0,0 +1,81 @@
+import sys
+import unittest
+import multiprocessing
+from dynd import nd, ndt
+
+def _sum_shared(name, queue):
+    a = nd.from_shared(name)
+    queue.put(sum(nd.as_py(a)))
+
+@unittest.skipIf(sys.platform == 'win32',
+                 'shared memory arrays require POSIX shm_open')
+class TestSharedMemory(unittest.TestCase):
+    def setUp(self):
+        self.names = []
+
+    def tearDown(self):
+        for name in self.names:
+            nd.shared_unlink(name)
+
+    def make_shared(self, tp):
+        a = nd.shared_empty(tp)
+        self.names.append(nd.shared_name(a))
+        return a
+
+    def test_roundtrip(self):
+        a = self.make_shared('3 * int32')
+        a[...] = [1, 2, 3]
+        name = nd.shared_name(a)
+        self.assertTrue(name.startswith('/'))
+        b = nd.from_shared(name)
+        self.assertEqual(nd.type_of(b), ndt.type('3 * int32'))
+        self.assertEqual(nd.as_py(b), [1, 2, 3])
+        self.assertEqual(nd.shared_name(b), name)
+        # Views share the memory, not copies
+        a[1] = 10
+        self.assertEqual(nd.as_py(b), [1, 10, 3])
+        self.assertEqual(nd.shared_name(a[1:]), name)
+        self.assertEqual(nd.shared_name(nd.array([1, 2])), None)
+
+    def test_access(self):
+        a = self.make_shared('2 * float64')
+        a[...] = [1.5, 2.5]
+        b = nd.from_shared(nd.shared_name(a))
+        self.assertEqual(b.access_flags, 'readonly')
+        self.assertRaises(RuntimeError, b.__setitem__, 0, 3.0)
+        c = nd.from_shared(nd.shared_name(a), access='readwrite')
+        c[0] = 3.0
+        self.assertEqual(nd.as_py(a), [3.0, 2.5])
+
+    def test_struct(self):
+        a = self.make_shared('2 * {x: int16, y: float64}')
+        a[...] = [(1, 2.5), (3, 4.5)]
+        b = nd.from_shared(nd.shared_name(a))
+        self.assertEqual(nd.as_py(b), [{'x': 1, 'y': 2.5}, {'x': 3, 'y': 4.5}])
+
+    def test_unlinked(self):
+        a = nd.shared_empty('int64')
+        a[...] = 7
+        name = nd.shared_name(a)
+        b = nd.from_shared(name)
+        nd.shared_unlink(name)
+        # Attached arrays stay valid, but the name is gone
+        self.assertEqual(nd.as_py(b), 7)
+        self.assertRaises(RuntimeError, nd.from_shared, name)
+
+    def test_unsupported_type(self):
+        self.assertRaises(TypeError, nd.shared_empty, '3 * string')
+        self.assertRaises(TypeError, nd.shared_empty, 'var * int32')
+
+    def test_other_process(self):
+        a = self.make_shared('1000 * int64')
+        a[...] = nd.range(1000, dtype=ndt.int64)
+        queue = multiprocessing.Queue()
+        p = multiprocessing.Process(target=_sum_shared,
+                                    args=(nd.shared_name(a), queue))
+        p.start()
+        self.assertEqual(queue.get(timeout=30), sum(range(1000)))
+        p.join()
+
+if __name__ == '__main__':
+    unittest.main()
@@ -57,5 +57,37 @@ class TestDType(unittest.TestCase):
         self.assertEqual(nd.as_py(colors), color_vals)
         self.assertEqual(nd.as_py(colors.ints), color_vals_int)
 
+    def test_factorize_strings(self):
+        vals = ['M', 'M', 'F', 'F', 'M', 'F', 'M']
+        codes, tp = nd.factorize(vals)
+        self.assertEqual(tp, ndt.factor_categorical(vals))
+        self.assertEqual(nd.as_py(codes), [1, 1, 0, 0, 1, 0, 1])
+        self.assertEqual(nd.dtype_of(codes), tp.storage_type)
+        codes, tp = nd.factorize(vals, sort=False)
+        self.assertEqual(nd.as_py(tp.categories), ['M', 'F'])
+        self.assertEqual(nd.as_py(codes), [0, 0, 1, 1, 0, 1, 0])
+        self.assertEqual(nd.as_py(codes.view_scalars(tp)), vals)
+
+    def test_factorize_ints(self):
+        vals = [(i * 7919) % 1000 - 500 for i in range(5000)]
+        codes, tp = nd.factorize(nd.array(vals, dtype=ndt.int64))
+        self.assertEqual(tp.category_type, ndt.int64)
+        self.assertEqual(tp.storage_type, ndt.uint16)
+        self.assertEqual(nd.as_py(tp.categories), sorted(set(vals)))
+        self.assertEqual(nd.as_py(codes.view_scalars(tp)), vals)
+        # A strided view, and an expression which is evaluated first
+        a = nd.array(vals, dtype=ndt.int32)[::-3]
+        codes, tp = nd.factorize(a.ucast(ndt.int16), sort=False)
+        self.assertEqual(tp.category_type, ndt.int16)
+        self.assertEqual(nd.as_py(codes.view_scalars(tp)), vals[::-3])
+
+    def test_factorize_general(self):
+        # Other types go through factor_categorical
+        vals = [1.5, -2, 1.5, 3]
+        codes, tp = nd.factorize(vals)
+        self.assertEqual(nd.as_py(tp.categories), [-2, 1.5, 3])
+        self.assertEqual(nd.as_py(codes), [1, 0, 1, 2])
+        self.assertRaises(ValueError, nd.factorize, [[1, 2], [3, 4]])
+
 if __name__ == '__main__':
     unittest.main()
@@ -10,6 +10,7 @@
 #include "type_functions.hpp"
 #include "utility_functions.hpp"
 #include "copy_to_pyobject_arrfunc.hpp"
+#include "string_conversion.hpp"
 #include <dynd/types/base_struct_type.hpp>
 #include <dynd/types/date_type.hpp>
 #include <dynd/types/time_type.hpp>
@@ -22,8 +23,12 @@ using namespace std;
 using namespace dynd;
 using namespace pydynd;
 
-PyObject *pydynd::array_as_py(const dynd::nd::array &a, bool struct_as_pytuple)
+PyObject *pydynd::array_as_py(const dynd::nd::array &a, bool struct_as_pytuple,
+                              bool dedupe_strings)
 {
+  // The string kernels instantiated below pick up the current table
+  pystring_dedupe_table dedupe;
+  pystring_dedupe_table::scope dedupe_scope(dedupe_strings ? &dedupe : NULL);
   pyobject_ownref result;
 
   // TODO: This is a hack, need a proper way to pass this dst param
@@ -25,11 +25,13 @@
 #include "array_from_py.hpp"
 #include "array_from_py_typededuction.hpp"
 #include "array_from_py_dynamic.hpp"
+#include "datetime_conversion.hpp"
 #include "array_assign_from_py.hpp"
 #include "array_functions.hpp"
 #include "type_functions.hpp"
 #include "utility_functions.hpp"
 #include "numpy_interop.hpp"
+#include "string_conversion.hpp"
 
 using namespace std;
 using namespace dynd;
@@ -205,9 +207,7 @@ convert_one_pyscalar_date(const ndt::type &tp, const char *arrmeta, char *out,
     if (!PyDate_Check(obj)) {
         throw dynd::type_error("input object is not a date as expected");
     }
-    const ndt::date_type *dd = tp.extended<ndt::date_type>();
-    dd->set_ymd(arrmeta, out, assign_error_fractional, PyDateTime_GET_YEAR(obj),
-                    PyDateTime_GET_MONTH(obj), PyDateTime_GET_DAY(obj));
+    *reinterpret_cast<int32_t *>(out) = pydate_to_days(obj);
 }
 
 inline void
@@ -233,15 +233,8 @@ convert_one_pyscalar_datetime(const ndt::type &tp, const char *arrmeta,
     if (!PyDateTime_Check(obj)) {
         throw dynd::type_error("input object is not a datetime as expected");
     }
-    if (((PyDateTime_DateTime *)obj)->hastzinfo &&
-                    ((PyDateTime_DateTime *)obj)->tzinfo != NULL) {
-        throw runtime_error("Converting datetimes with a timezone to dynd arrays is not yet supported");
-    }
-    const ndt::datetime_type *dd = tp.extended<ndt::datetime_type>();
-    dd->set_cal(arrmeta, out, assign_error_fractional, PyDateTime_GET_YEAR(obj),
-                    PyDateTime_GET_MONTH(obj), PyDateTime_GET_DAY(obj),
-                    PyDateTime_DATE_GET_HOUR(obj), PyDateTime_DATE_GET_MINUTE(obj),
-                    PyDateTime_DATE_GET_SECOND(obj), PyDateTime_DATE_GET_MICROSECOND(obj) * 10);
+    // An aware datetime is stored as UTC
+    *reinterpret_cast<int64_t *>(out) = pydatetime_to_ticks(obj);
 }
 
 inline void convert_one_pyscalar_ndt_type(const ndt::type &DYND_UNUSED(tp),
@@ -266,11 +259,81 @@ inline void convert_one_pyscalar_option(const ndt::type &tp,
     }
 }
 
+/**
+ * Adapts a convert_one_pyscalar function for fill_array_from_pylist.
+ */
 template <convert_one_pyscalar_function_t ConvertOneFn>
+struct convert_one_pyscalar_fn {
+    inline void operator()(const ndt::type &tp, const char *arrmeta, char *out,
+                           PyObject *obj, const eval::eval_context *ectx) const
+    {
+        ConvertOneFn(tp, arrmeta, out, obj, ectx);
+    }
+};
+
+#if PY_VERSION_HEX >= 0x03030000
+/**
+ * Converts unicode objects into UTF-8 strings, placing their data one
+ * after another in an arena allocated up front for the whole list,
+ * instead of allocating each string from the memory block separately.
+ * Strings which don't fit, or can't be encoded directly, go through
+ * convert_one_pyscalar_ustring.
+ */
+struct convert_one_pyscalar_ustring_arena {
+    struct arena {
+        char *begin, *end;
+    };
+    arena *m_arena;
+
+    explicit convert_one_pyscalar_ustring_arena(arena *a) : m_arena(a) {}
+
+    inline void operator()(const ndt::type &tp, const char *arrmeta, char *out,
+                           PyObject *obj, const eval::eval_context *ectx) const
+    {
+        if (PyUnicode_Check(obj) && PyUnicode_IS_READY(obj) &&
+                pyunicode_utf8_size(obj) <= m_arena->end - m_arena->begin) {
+            char *end = pyunicode_encode_utf8(obj, m_arena->begin);
+            if (end != NULL) {
+                pyunicode_string_ptrs *out_usp =
+                    reinterpret_cast<pyunicode_string_ptrs *>(out);
+                out_usp->begin = m_arena->begin;
+                out_usp->end = end;
+                m_arena->begin = end;
+                return;
+            }
+        }
+        convert_one_pyscalar_ustring(tp, arrmeta, out, obj, ectx);
+    }
+};
+
+/**
+ * Sums the UTF-8 sizes of the unicode objects in a nested list,
+ * ``ndim`` levels deep.
+ */
+static void add_pylist_utf8_size(PyObject *obj, size_t ndim, intptr_t &total)
+{
+    if (ndim == 0 || !PyList_Check(obj)) {
+        if (PyUnicode_Check(obj)) {
+            if (PyUnicode_READY(obj) < 0) {
+                throw exception();
+            }
+            total += pyunicode_utf8_size(obj);
+        }
+        return;
+    }
+    Py_ssize_t size = PyList_GET_SIZE(obj);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        add_pylist_utf8_size(PyList_GET_ITEM(obj, i), ndim - 1, total);
+    }
+}
+#endif
+
+template <typename ConvertOne>
 static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta,
                                    char *data, PyObject *obj,
                                    const intptr_t *shape, size_t current_axis,
-                                   const eval::eval_context *ectx)
+                                   const eval::eval_context *ectx,
+                                   const ConvertOne &convert_one)
 {
     if (shape[current_axis] == 0) {
         return;
@@ -287,15 +350,15 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta,
       if (element_tp.is_scalar()) {
         for (Py_ssize_t i = 0; i < size; ++i) {
           PyObject *item = PyList_GET_ITEM(obj, i);
-          ConvertOneFn(element_tp, element_arrmeta, data, item, ectx);
+          convert_one(element_tp, element_arrmeta, data, item, ectx);
           data += stride;
         }
       }
       else {
         for (Py_ssize_t i = 0; i < size; ++i) {
-          fill_array_from_pylist<ConvertOneFn>(element_tp, element_arrmeta,
-                                               data, PyList_GET_ITEM(obj, i),
-                                               shape, current_axis + 1, ectx);
+          fill_array_from_pylist(element_tp, element_arrmeta, data,
+                                 PyList_GET_ITEM(obj, i), shape,
+                                 current_axis + 1, ectx, convert_one);
           data += stride;
         }
       }
@@ -314,15 +377,16 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta,
         if (element_tp.is_scalar()) {
             for (Py_ssize_t i = 0; i < size; ++i) {
                 PyObject *item = PyList_GET_ITEM(obj, i);
-                ConvertOneFn(element_tp, element_arrmeta, element_data, item,
-                             ectx);
+                convert_one(element_tp, element_arrmeta, element_data, item,
+                            ectx);
                 element_data += stride;
             }
         } else {
             for (Py_ssize_t i = 0; i < size; ++i) {
-                fill_array_from_pylist<ConvertOneFn>(
-                    element_tp, element_arrmeta, element_data,
-                    PyList_GET_ITEM(obj, i), shape, current_axis + 1, ectx);
+                fill_array_from_pylist(element_tp, element_arrmeta,
+                                       element_data, PyList_GET_ITEM(obj, i),
+                                       shape, current_axis + 1, ectx,
+                                       convert_one);
                 element_data += stride;
             }
         }
@@ -356,46 +420,77 @@ static dynd::nd::array array_from_pylist(PyObject *obj,
     // Populate the array with data
     switch (tp.get_type_id()) {
         case bool_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_bool>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_bool>());
             break;
         case int32_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_int32>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_int32>());
             break;
         case int64_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_int64>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_int64>());
             break;
         case float32_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_float32>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_float32>());
             break;
         case float64_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_float64>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_float64>());
             break;
         case complex_float64_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_cdouble>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_cdouble>());
             break;
         case bytes_type_id:
-            fill_array_from_pylist<convert_one_pyscalar_bytes>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_bytes>());
             break;
         case string_type_id: {
             const ndt::base_string_type *ext = tp.extended<ndt::base_string_type>();
             if (ext->get_encoding() == string_encoding_utf_8) {
-                fill_array_from_pylist<convert_one_pyscalar_ustring>(
+#if PY_VERSION_HEX >= 0x03030000
+                // Measure all the strings first, so their data can go in
+                // one contiguous allocation
+                intptr_t total_size = 0;
+                add_pylist_utf8_size(obj, shape.size(), total_size);
+                char *str_arrmeta = result.get_arrmeta();
+                result.get_type().get_type_at_dimension(&str_arrmeta,
+                                                        (intptr_t)shape.size());
+                const string_type_arrmeta *md =
+                    reinterpret_cast<const string_type_arrmeta *>(str_arrmeta);
+                convert_one_pyscalar_ustring_arena::arena arena = {NULL, NULL};
+                if (total_size > 0) {
+                    memory_block_pod_allocator_api *allocator =
+                        get_memory_block_pod_allocator_api(md->blockref);
+                    allocator->allocate(md->blockref, total_size, 1,
+                                        &arena.begin, &arena.end);
+                }
+                fill_array_from_pylist(
+                    result.get_type(), result.get_arrmeta(),
+                    result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                    convert_one_pyscalar_ustring_arena(&arena));
+#else
+                fill_array_from_pylist(
                     result.get_type(), result.get_arrmeta(),
-                    result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                    result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                    convert_one_pyscalar_fn<convert_one_pyscalar_ustring>());
+#endif
             } else {
                 stringstream ss;
                 ss << "Internal error: deduced type from Python list, " << tp
@@ -405,33 +500,38 @@ static dynd::nd::array array_from_pylist(PyObject *obj,
             break;
         }
         case date_type_id: {
-            fill_array_from_pylist<convert_one_pyscalar_date>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_date>());
             break;
         }
         case time_type_id: {
-            fill_array_from_pylist<convert_one_pyscalar_time>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_time>());
             break;
         }
         case datetime_type_id: {
-            fill_array_from_pylist<convert_one_pyscalar_datetime>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_datetime>());
             break;
         }
         case type_type_id: {
-            fill_array_from_pylist<convert_one_pyscalar_ndt_type>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_ndt_type>());
             break;
         }
         case option_type_id: {
-            fill_array_from_pylist<convert_one_pyscalar_option>(
+            fill_array_from_pylist(
                 result.get_type(), result.get_arrmeta(),
-                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx);
+                result.get_readwrite_originptr(), obj, &shape[0], 0, ectx,
+                convert_one_pyscalar_fn<convert_one_pyscalar_option>());
             break;
         }
         default: {
@@ -597,27 +697,15 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags,
     result = nd::make_string_array(s, len, string_encoding_utf_8,
                                    nd::readwrite_access_flags);
   } else if (PyDateTime_Check(obj)) {
-    if (((PyDateTime_DateTime *)obj)->hastzinfo &&
-        ((PyDateTime_DateTime *)obj)->tzinfo != NULL) {
-      throw runtime_error("Converting datetimes with a timezone to dynd "
-                          "arrays is not yet supported");
-    }
-    ndt::type d = ndt::make_datetime();
-    const ndt::datetime_type *dd = d.extended<ndt::datetime_type>();
-    result = nd::empty(d);
-    dd->set_cal(result.get_arrmeta(), result.get_ndo()->m_data_pointer,
-                assign_error_fractional, PyDateTime_GET_YEAR(obj),
-                PyDateTime_GET_MONTH(obj), PyDateTime_GET_DAY(obj),
-                PyDateTime_DATE_GET_HOUR(obj), PyDateTime_DATE_GET_MINUTE(obj),
-                PyDateTime_DATE_GET_SECOND(obj),
-                PyDateTime_DATE_GET_MICROSECOND(obj) * 10);
+    // An aware datetime is stored as UTC
+    result = nd::empty(
+        ndt::make_datetime(pydatetime_is_aware(obj) ? tz_utc : tz_abstract));
+    *reinterpret_cast<int64_t *>(result.get_ndo()->m_data_pointer) =
+        pydatetime_to_ticks(obj);
   } else if (PyDate_Check(obj)) {
-    ndt::type d = ndt::make_date();
-    const ndt::date_type *dd = d.extended<ndt::date_type>();
-    result = nd::empty(d);
-    dd->set_ymd(result.get_arrmeta(), result.get_ndo()->m_data_pointer,
-                assign_error_fractional, PyDateTime_GET_YEAR(obj),
-                PyDateTime_GET_MONTH(obj), PyDateTime_GET_DAY(obj));
+    result = nd::empty(ndt::make_date());
+    *reinterpret_cast<int32_t *>(result.get_ndo()->m_data_pointer) =
+        pydate_to_days(obj);
   } else if (PyTime_Check(obj)) {
     if (((PyDateTime_DateTime *)obj)->hastzinfo &&
         ((PyDateTime_DateTime *)obj)->tzinfo != NULL) {
@@ -681,6 +769,38 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags,
   return result;
 }
 
+/**
+ * When converting a list or tuple to a scalar dtype, guesses the full
+ * type from its length and first element alone, trusting that the
+ * remaining elements are scalars too. This skips the pass over every
+ * element that deduce_pyseq_shape_using_dtype makes. Returns an
+ * uninitialized type if the input doesn't look like a flat sequence
+ * of scalars.
+ */
+static ndt::type trusted_pyseq_type(PyObject *obj, const ndt::type &tp)
+{
+  if ((!PyList_Check(obj) && !PyTuple_Check(obj)) || tp.get_ndim() > 0 ||
+      tp.is_symbolic() || tp.get_kind() == struct_kind ||
+      tp.get_kind() == tuple_kind) {
+    return ndt::type();
+  }
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
+  if (size == 0) {
+    return ndt::type();
+  }
+  // The same test for a dimension as deduce_pyseq_shape_using_dtype
+  PyObject *first = PySequence_Fast_GET_ITEM(obj, 0);
+  bool is_sequence = (PySequence_Check(first) != 0 &&
+                      !PyUnicode_Check(first) && !PyDict_Check(first));
+#if PY_VERSION_HEX < 0x03000000
+  is_sequence = is_sequence && !PyString_Check(first);
+#endif
+  if (is_sequence) {
+    return ndt::type();
+  }
+  return ndt::make_fixed_dim(size, tp);
+}
+
 dynd::nd::array pydynd::array_from_py(PyObject *obj, const ndt::type &tp,
                                       bool fulltype, uint32_t access_flags,
                                       const dynd::eval::eval_context *ectx)
@@ -688,6 +808,48 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, const ndt::type &tp,
   ndt::type tpfull;
   nd::array result;
   if (!fulltype) {
+    // Try the flat sequence of scalars type first, converting with the
+    // per-type loops directly. If an element turns out not to fit, the
+    // partial result is dropped, and the full deduction below reports
+    // or handles it. Any other error, like a KeyboardInterrupt from an
+    // element's __float__, is raised as it is.
+    tpfull = trusted_pyseq_type(obj, tp);
+    if (tpfull.get_type_id() != uninitialized_type_id) {
+      bool fall_back = false;
+      try {
+        result = nd::empty(tpfull);
+        array_no_dim_broadcast_assign_from_py(
+            result.get_type(), result.get_arrmeta(),
+            result.get_readwrite_originptr(), obj, ectx);
+      }
+      catch (const dynd::broadcast_error &) {
+        fall_back = true;
+      }
+      catch (const dynd::type_error &) {
+        fall_back = true;
+      }
+      catch (const exception &) {
+        // A Python error raised while converting an element
+        if (!PyErr_Occurred() ||
+            !(PyErr_ExceptionMatches(PyExc_TypeError) ||
+              PyErr_ExceptionMatches(PyExc_ValueError) ||
+              PyErr_ExceptionMatches(PyExc_OverflowError))) {
+          throw;
+        }
+        fall_back = true;
+      }
+      if (fall_back) {
+        PyErr_Clear();
+        result = nd::array();
+      }
+      else {
+        if (access_flags != 0 && (access_flags & nd::write_access_flag) == 0) {
+          result.flag_as_immutable();
+        }
+        return result;
+      }
+    }
+
     if (PyUnicode_Check(obj)
 #if PY_VERSION_HEX < 0x03000000
         || PyString_Check(obj)
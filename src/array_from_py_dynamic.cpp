@@ -36,6 +36,25 @@ using namespace pydynd;
 
 static const intptr_t ARRAY_FROM_DYNAMIC_INITIAL_COUNT = 16;
 
+namespace {
+
+/**
+ * Counters of the data array_from_py_dynamic moves around
+ * while promoting, accessed with the GIL held.
+ */
+struct afpd_stats {
+    // The number of times the dtype was promoted
+    intptr_t dtype_promotions;
+    // The number of times a dimension was promoted from fixed to var
+    intptr_t dim_promotions;
+    // The number of bytes of element data copied into a new array
+    intptr_t bytes_copied;
+};
+
+afpd_stats stats = {0, 0, 0};
+
+} // anonymous namespace
+
 void pydynd::init_array_from_py_dynamic()
 {
   // Initialize the pydatetime API
@@ -183,6 +202,7 @@ static void copy_to_promoted_nd_arr(
         char *src = const_cast<char *>(src_data_ptr);
         fn(dst_data_ptr, dst_md->stride, &src, &src_md->stride,
            shape[current_axis], ck.get());
+        stats.bytes_copied += dst_md->stride * shape[current_axis];
       }
       else {
         expr_strided_t fn = ck.get()->get_function<expr_strided_t>();
@@ -190,6 +210,8 @@ static void copy_to_promoted_nd_arr(
         char *src = const_cast<char *>(src_data_ptr);
         fn(dst_data_ptr, dst_md->stride, &src, &src_md->stride,
            src_coord[current_axis].coord + int(copy_final_coord), ck.get());
+        stats.bytes_copied += dst_md->stride * (src_coord[current_axis].coord +
+                                                int(copy_final_coord));
         dst_coord[current_axis].coord = src_coord[current_axis].coord;
         dst_coord[current_axis].data_ptr =
             dst_data_ptr + dst_md->stride * dst_coord[current_axis].coord;
@@ -216,6 +238,7 @@ static void copy_to_promoted_nd_arr(
         char *src = src_d->begin;
         fn(dst_d->begin, dst_md->stride, &src, &src_md->stride,
            src_d->size, ck.get());
+        stats.bytes_copied += dst_md->stride * src_d->size;
       }
       else {
         // Initialize the var element to the same reserved space as the
@@ -231,6 +254,9 @@ static void copy_to_promoted_nd_arr(
           char *src = src_d->begin;
           fn(dst_d->begin, dst_md->stride, &src, &src_md->stride,
              src_coord[current_axis].coord + int(copy_final_coord), ck.get());
+          stats.bytes_copied +=
+              dst_md->stride *
+              (src_coord[current_axis].coord + int(copy_final_coord));
         }
         dst_coord[current_axis].coord = src_coord[current_axis].coord;
         dst_coord[current_axis].data_ptr =
@@ -355,6 +381,7 @@ static void promote_nd_arr_dtype(const std::vector<intptr_t> &shape,
   }
   else {
     newelem.dtp = promote_types_arithmetic(elem.dtp, tp);
+    ++stats.dtype_promotions;
   }
   // Create the new array
   nd::array newarr = allocate_nd_arr(shape, newcoord, newelem, ndim);
@@ -395,6 +422,7 @@ static void promote_nd_arr_dim(std::vector<intptr_t> &shape,
   vector<afpd_coordentry> newcoord;
   afpd_dtype newelem;
   newelem.dtp = elem.dtp;
+  ++stats.dim_promotions;
   // Convert the axis into a var dim
   shape[axis] = -1;
   // Create the new array
@@ -1236,9 +1264,172 @@ static void array_from_py_dynamic(PyObject *obj, std::vector<intptr_t> &shape,
     throw runtime_error(ss.str());
 }
 
+static bool is_numeric_pyscalar(PyObject *obj)
+{
+    return PyBool_Check(obj) || PyLong_Check(obj) ||
+#if PY_VERSION_HEX < 0x03000000
+           PyInt_Check(obj) ||
+#endif
+           PyFloat_Check(obj) || PyComplex_Check(obj);
+}
+
+/**
+ * Assigns a numeric scalar to an element of type `tp`, returning
+ * false if the value requires a promoted type.
+ */
+static bool numeric_assign(const ndt::type &tp, char *data, PyObject *obj,
+                           const eval::eval_context *ectx)
+{
+    switch (tp.get_kind()) {
+        case bool_kind:
+            return bool_assign(data, obj);
+        case sint_kind:
+            return int_assign(tp, data, obj);
+        case real_kind:
+            return real_assign(data, obj);
+        case complex_kind:
+            return complex_assign(data, obj);
+        default:
+            array_broadcast_assign_from_py(tp, NULL, data, obj, ectx);
+            return true;
+    }
+}
+
+namespace {
+
+/**
+ * A run of values converted to one dtype. Its chunk
+ * may be only partly filled.
+ */
+struct afpd_segment {
+    nd::array chunk;
+    intptr_t size;
+    intptr_t capacity;
+};
+
+} // anonymous namespace
+
+/**
+ * Converts the remaining values of an iterator of numeric scalars,
+ * after its first value `first`, into a one dimensional array.
+ *
+ * The values go into chunks of doubling capacity, so the values
+ * converted so far are never reallocated. A value which needs a
+ * promoted dtype starts a new segment in that dtype, leaving the
+ * earlier segments as they are, and each segment is copied into
+ * the result once, at the end. This makes a late promotion cost
+ * nothing extra, where the general code copies everything so far.
+ */
+static nd::array array_from_py_numeric_iter(PyObject *iter, PyObject *first,
+                                            const eval::eval_context *ectx)
+{
+    vector<afpd_segment> segments;
+    ndt::type dtp = deduce_ndt_type_from_pyobject(first);
+    intptr_t capacity = ARRAY_FROM_DYNAMIC_INITIAL_COUNT;
+    intptr_t total_size = 0;
+
+    pyobject_ownref item(first);
+    for (;;) {
+        if (segments.empty() || segments.back().size == segments.back().capacity) {
+            afpd_segment seg;
+            seg.chunk = nd::empty(capacity, dtp);
+            seg.size = 0;
+            seg.capacity = capacity;
+            segments.push_back(seg);
+            capacity *= 2;
+        }
+        afpd_segment *seg = &segments.back();
+        char *data = seg->chunk.get_readwrite_originptr() +
+                     seg->size * dtp.get_data_size();
+        if (!numeric_assign(dtp, data, item.get(), ectx)) {
+            dtp = promote_types_arithmetic(
+                dtp, deduce_ndt_type_from_pyobject(item.get()));
+            ++stats.dtype_promotions;
+            afpd_segment promoted;
+            promoted.chunk = nd::empty(capacity, dtp);
+            promoted.size = 0;
+            promoted.capacity = capacity;
+            segments.push_back(promoted);
+            capacity *= 2;
+            seg = &segments.back();
+            data = seg->chunk.get_readwrite_originptr();
+            array_broadcast_assign_from_py(dtp, NULL, data, item.get(), ectx);
+        }
+        ++seg->size;
+        ++total_size;
+        PyObject *next = PyIter_Next(iter);
+        if (next == NULL) {
+            break;
+        }
+        item.reset(next);
+    }
+    if (PyErr_Occurred()) {
+        // Propagate any error
+        throw exception();
+    }
+
+    nd::array result = nd::empty(total_size, dtp);
+    intptr_t offset = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const afpd_segment &seg = segments[i];
+        if (seg.size > 0) {
+            result(irange(offset, offset + seg.size))
+                .val_assign(seg.chunk(irange(0, seg.size)), ectx);
+            offset += seg.size;
+            stats.bytes_copied += seg.size * dtp.get_data_size();
+        }
+    }
+    return result;
+}
+
+PyObject *pydynd::array_from_py_dynamic_stats(bool reset)
+{
+    pyobject_ownref result(PyDict_New());
+    pyobject_ownref dtype_promotions(PyLong_FromSsize_t(stats.dtype_promotions));
+    pyobject_ownref dim_promotions(PyLong_FromSsize_t(stats.dim_promotions));
+    pyobject_ownref bytes_copied(PyLong_FromSsize_t(stats.bytes_copied));
+    if (PyDict_SetItemString(result.get(), "dtype_promotions",
+                             dtype_promotions.get()) < 0 ||
+            PyDict_SetItemString(result.get(), "dim_promotions",
+                                 dim_promotions.get()) < 0 ||
+            PyDict_SetItemString(result.get(), "bytes_copied",
+                                 bytes_copied.get()) < 0) {
+        throw exception();
+    }
+    if (reset) {
+        memset(&stats, 0, sizeof(stats));
+    }
+    return result.release();
+}
+
 dynd::nd::array pydynd::array_from_py_dynamic(PyObject *obj,
                                               const eval::eval_context *ectx)
 {
+    // A flat run of numeric scalars from a one pass iterator, the
+    // common case for generators, goes through
+    // array_from_py_numeric_iter. Other iterables are left to the
+    // general code, since calling __iter__ on them here and again
+    // there could see different items, or repeat side effects.
+    pyobject_ownref chained;
+    if (PyIter_Check(obj)) {
+        PyObject *first = PyIter_Next(obj);
+        if (first != NULL) {
+            if (is_numeric_pyscalar(first)) {
+                return array_from_py_numeric_iter(obj, first, ectx);
+            }
+            // Put back the first value for the general code
+            pyobject_ownref first_owner(first);
+            pyobject_ownref itertools(PyImport_ImportModule("itertools"));
+            chained.reset(PyObject_CallMethod(
+                itertools.get(), (char *)"chain", (char *)"(O)O",
+                first, obj));
+            obj = chained.get();
+        }
+        else if (PyErr_Occurred()) {
+            throw exception();
+        }
+    }
+
     std::vector<afpd_coordentry> coord;
     std::vector<intptr_t> shape;
     afpd_dtype elem;
@@ -20,6 +20,7 @@
 #include <dynd/exceptions.hpp>
 
 #include "array_from_py_typededuction.hpp"
+#include "datetime_conversion.hpp"
 #include "array_assign_from_py.hpp"
 #include "array_functions.hpp"
 #include "type_functions.hpp"
@@ -102,11 +103,9 @@ ndt::type pydynd::deduce_ndt_type_from_pyobject(PyObject* obj, bool throw_on_unk
         // Python string
         return ndt::make_string();
     } else if (PyDateTime_Check(obj)) {
-        if (((PyDateTime_DateTime *)obj)->hastzinfo &&
-                        ((PyDateTime_DateTime *)obj)->tzinfo != NULL) {
-            throw runtime_error("Converting datetimes with a timezone to dynd arrays is not yet supported");
-        }
-        return ndt::make_datetime();
+        // Aware datetimes are converted to UTC
+        return ndt::make_datetime(pydatetime_is_aware(obj) ? tz_utc
+                                                           : tz_abstract);
     } else if (PyDate_Check(obj)) {
         return ndt::make_date();
     } else if (PyTime_Check(obj)) {
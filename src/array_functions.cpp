@@ -10,6 +10,9 @@
 #include "type_functions.hpp"
 #include "utility_functions.hpp"
 #include "numpy_interop.hpp"
+#include "eval_context_functions.hpp"
+#include "datetime_parse.hpp"
+#include "parallel_eval.hpp"
 
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/base_dim_type.hpp>
@@ -440,14 +443,41 @@ dynd::nd::array pydynd::array_asarray(PyObject *obj, PyObject *access)
 
 dynd::nd::array pydynd::array_eval(const dynd::nd::array &n, PyObject *ectx_obj)
 {
-    return n.eval(eval_context_from_pyobj(ectx_obj));
+    const eval::eval_context *ectx = eval_context_from_pyobj(ectx_obj);
+    const eval_threading &threading = eval_threading_from_pyobj(ectx_obj);
+    if (is_string_to_datetime_column(n)) {
+        return eval_string_to_datetime_column(n, ectx, threading);
+    }
+    intptr_t nchunks = parallel_eval_chunks(n, threading);
+    if (nchunks > 1) {
+        nd::array result = nd::empty(n.get_type().get_canonical_type());
+        parallel_eval_assign(result, n, ectx, nchunks);
+        return result;
+    }
+    return n.eval(ectx);
 }
 
 dynd::nd::array pydynd::array_eval_copy(const dynd::nd::array &n,
                                         PyObject *access, PyObject *ectx_obj)
 {
     uint32_t access_flags = pyarg_creation_access_flags(access);
-    return n.eval_copy(access_flags, eval_context_from_pyobj(ectx_obj));
+    const eval::eval_context *ectx = eval_context_from_pyobj(ectx_obj);
+    const eval_threading &threading = eval_threading_from_pyobj(ectx_obj);
+    nd::array result;
+    if (is_string_to_datetime_column(n)) {
+        result = eval_string_to_datetime_column(n, ectx, threading);
+    } else {
+        intptr_t nchunks = parallel_eval_chunks(n, threading);
+        if (nchunks <= 1) {
+            return n.eval_copy(access_flags, ectx);
+        }
+        result = nd::empty(n.get_type().get_canonical_type());
+        parallel_eval_assign(result, n, ectx, nchunks);
+    }
+    if (access_flags != 0 && (access_flags & nd::write_access_flag) == 0) {
+        result.flag_as_immutable();
+    }
+    return result;
 }
 
 dynd::nd::array pydynd::array_zeros(const dynd::ndt::type& d, PyObject *access)
@@ -0,0 +1,192 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <Python.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/memblock/external_memory_block.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+
+#include "array_pickle.hpp"
+#include "array_functions.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+namespace {
+
+/**
+ * Returns true if the data of an array of this (value) type is one
+ * block of bytes which references no other memory, so it can be
+ * pickled as raw bytes.
+ */
+bool is_fixed_layout_type(const ndt::type &tp)
+{
+  if (tp.is_builtin()) {
+    return true;
+  }
+  return !tp.is_symbolic() &&
+         (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) == 0;
+}
+
+/**
+ * Returns a read-only ``N * uint8`` array viewing the data of ``a``,
+ * which must have the default C-contiguous layout.
+ */
+nd::array make_raw_bytes_view(const nd::array &a)
+{
+  ndt::type tp = ndt::make_fixed_dim(a.get_type().get_data_size(),
+                                     ndt::type(uint8_type_id));
+  nd::array result(make_array_memory_block(tp.get_arrmeta_size()));
+  tp.extended()->arrmeta_default_construct(result.get_arrmeta(), false);
+  result.get_ndo()->m_data_pointer = a.get_ndo()->m_data_pointer;
+  result.get_ndo()->m_data_reference = a.get_ndo()->m_data_reference;
+  if (result.get_ndo()->m_data_reference == NULL) {
+    result.get_ndo()->m_data_reference = a.get_memblock().get();
+  }
+  memory_block_incref(result.get_ndo()->m_data_reference);
+  tp.swap(result.get_ndo()->m_type);
+  result.get_ndo()->m_flags = nd::read_access_flag;
+  return result;
+}
+
+nd::array copy_from_buffer(const ndt::type &tp, const Py_buffer *view)
+{
+  nd::array result = nd::empty(tp);
+  memcpy(result.get_readwrite_originptr(), view->buf, view->len);
+  return result;
+}
+
+void check_buffer_size(const ndt::type &tp, const Py_buffer *view)
+{
+  if (view->len != static_cast<Py_ssize_t>(tp.get_data_size())) {
+    stringstream ss;
+    ss << "pickled data of " << view->len << " bytes does not match dynd type "
+       << tp << ", which has " << tp.get_data_size() << " bytes";
+    throw runtime_error(ss.str());
+  }
+}
+
+} // anonymous namespace
+
+PyObject *pydynd::array_pickle_state(PyObject *a_obj, int protocol)
+{
+  if (!WArray_Check(a_obj)) {
+    throw invalid_argument("expected an nd.array object");
+  }
+  // Evaluate any expression types, so only the value is pickled
+  nd::array a = ((WArray *)a_obj)->v.eval();
+  const ndt::type &tp = a.get_type();
+
+  stringstream ss;
+  ss << tp;
+  pyobject_ownref type_obj(pystring_from_string(ss.str()));
+  pyobject_ownref kind_obj;
+  pyobject_ownref data_obj;
+
+  if (is_fixed_layout_type(tp)) {
+    // Only fixed dimensions of builtin types can be used as they are,
+    // anything else is copied to get the default layout
+    if (!a.get_dtype().is_builtin() || !array_is_c_contiguous(a)) {
+      a = a.eval_copy();
+    }
+#if PY_VERSION_HEX >= 0x03080000
+    if (protocol >= 5) {
+      // The PickleBuffer can be handed to the pickler's buffer
+      // callback, so the data is never copied into the stream
+      pyobject_ownref bytes_view(wrap_array(make_raw_bytes_view(a)));
+      kind_obj.reset(pystring_from_string("buffer"));
+      data_obj.reset(PyPickleBuffer_FromObject(bytes_view.get()));
+    }
+    else
+#endif
+    {
+      kind_obj.reset(pystring_from_string("raw"));
+      data_obj.reset(PyBytes_FromStringAndSize(a.get_readonly_originptr(),
+                                               tp.get_data_size()));
+    }
+  }
+  else {
+    kind_obj.reset(pystring_from_string("py"));
+    data_obj.reset(array_as_py(a, false));
+  }
+
+  return PyTuple_Pack(3, type_obj.get(), kind_obj.get(), data_obj.get());
+}
+
+nd::array pydynd::array_from_pickle_state(PyObject *type_obj,
+                                          PyObject *kind_obj, PyObject *data)
+{
+  ndt::type tp(pystring_as_string(type_obj));
+  string kind = pystring_as_string(kind_obj);
+
+  if (kind == "py") {
+    return array_from_py(data, tp, true,
+                         nd::read_access_flag | nd::write_access_flag,
+                         &eval::default_eval_context);
+  }
+  else if (kind == "raw") {
+    Py_buffer view;
+    if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
+      throw exception();
+    }
+    try {
+      check_buffer_size(tp, &view);
+      nd::array result = copy_from_buffer(tp, &view);
+      PyBuffer_Release(&view);
+      return result;
+    }
+    catch (...) {
+      PyBuffer_Release(&view);
+      throw;
+    }
+  }
+  else if (kind == "buffer") {
+    // The memoryview holds the buffer export for as long as
+    // the array viewing it is alive
+    pyobject_ownref mv(PyMemoryView_FromObject(data));
+    const Py_buffer *view = PyMemoryView_GET_BUFFER(mv.get());
+    if (!PyBuffer_IsContiguous(const_cast<Py_buffer *>(view), 'C')) {
+      throw runtime_error("pickled dynd array data is not contiguous");
+    }
+    check_buffer_size(tp, view);
+    if (tp.get_flags() & type_flag_destructor) {
+      stringstream ss;
+      ss << "Cannot view raw memory using dynd type " << tp;
+      throw type_error(ss.str());
+    }
+    // A read-only buffer, such as the bytes object an in-band pickle
+    // stores, is copied so the result is writable like at protocols
+    // before 5. Only writable out-of-band buffers are viewed in place.
+    if (view->readonly ||
+        reinterpret_cast<uintptr_t>(view->buf) % tp.get_data_alignment() !=
+            0) {
+      return copy_from_buffer(tp, view);
+    }
+
+    nd::array result(make_array_memory_block(tp.get_arrmeta_size()));
+    if (tp.get_arrmeta_size() > 0) {
+      tp.extended()->arrmeta_default_construct(result.get_arrmeta(), false);
+    }
+    result.get_ndo()->m_data_pointer = reinterpret_cast<char *>(view->buf);
+    result.get_ndo()->m_flags = nd::read_access_flag | nd::write_access_flag;
+    memory_block_ptr owner_memblock =
+        make_external_memory_block(mv.get(), &py_decref_function);
+    result.get_ndo()->m_data_reference = owner_memblock.release();
+    mv.release();
+    tp.swap(result.get_ndo()->m_type);
+    return result;
+  }
+  else {
+    stringstream ss;
+    ss << "unrecognized pickled dynd array kind \"" << kind << "\"";
+    throw runtime_error(ss.str());
+  }
+}
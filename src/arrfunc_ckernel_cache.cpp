@@ -0,0 +1,247 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <cstring>
+#include <map>
+
+#include "arrfunc_ckernel_cache.hpp"
+#include "arrfunc_functions.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+namespace {
+
+// FNV-1a, to screen out mismatched arrmeta before comparing it
+size_t hash_bytes(const char *data, size_t size, size_t h)
+{
+  for (size_t i = 0; i < size; ++i) {
+    h = (h ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+  }
+  return h;
+}
+
+/**
+ * Concatenates the raw source arrmeta into ``out``, returning its hash.
+ */
+size_t gather_arrmeta(intptr_t nsrc, const ndt::type *src_tp,
+                      const char *const *src_arrmeta, string &out)
+{
+  out.clear();
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    size_t size = src_tp[i].is_builtin() ? 0 : src_tp[i].get_arrmeta_size();
+    if (size > 0) {
+      out.append(src_arrmeta[i], size);
+    }
+  }
+  return hash_bytes(out.data(), out.size(),
+                    static_cast<size_t>(14695981039346656037ULL));
+}
+
+/**
+ * Copies the arrmeta of a type into ``out``, returning a pointer to
+ * the copy, or NULL if the type has no arrmeta.
+ */
+const char *copy_arrmeta(const ndt::type &tp, const char *arrmeta,
+                         vector<intptr_t> &out)
+{
+  size_t size = tp.is_builtin() ? 0 : tp.get_arrmeta_size();
+  if (size == 0) {
+    return NULL;
+  }
+  out.resize((size + sizeof(intptr_t) - 1) / sizeof(intptr_t));
+  memcpy(&out[0], arrmeta, size);
+  return reinterpret_cast<const char *>(&out[0]);
+}
+
+bool same_eval_context(const eval::eval_context &lhs,
+                       const eval::eval_context &rhs)
+{
+  return lhs.errmode == rhs.errmode &&
+         lhs.cuda_device_errmode == rhs.cuda_device_errmode &&
+         lhs.date_parse_order == rhs.date_parse_order &&
+         lhs.century_window == rhs.century_window;
+}
+
+} // anonymous namespace
+
+bool arrfunc_ckernel_cache::is_cacheable_type(const ndt::type &tp)
+{
+  if (tp.is_builtin()) {
+    return true;
+  }
+  return !tp.is_symbolic() && (tp.get_flags() & type_flag_blockref) == 0;
+}
+
+void arrfunc_ckernel_cache::check_arrfunc(const nd::arrfunc &af)
+{
+  if (af.get() != m_af) {
+    // The arrfunc was replaced, so everything cached is stale
+    shrink_to(0);
+    m_af = af.get();
+  }
+}
+
+void arrfunc_ckernel_cache::shrink_to(size_t size)
+{
+  // Drop from the least recently used end, skipping any ckernel
+  // which is executing further up the stack
+  list<unique_ptr<cached_ckernel>>::iterator it = m_entries.end();
+  while (m_entries.size() > size && it != m_entries.begin()) {
+    --it;
+    if (!(*it)->in_use) {
+      it = m_entries.erase(it);
+      ++m_evictions;
+    }
+  }
+}
+
+cached_ckernel *arrfunc_ckernel_cache::find(const nd::arrfunc &af,
+                                            const ndt::type &dst_tp,
+                                            intptr_t nsrc,
+                                            const ndt::type *src_tp,
+                                            const char *const *src_arrmeta,
+                                            const eval::eval_context *ectx)
+{
+  check_arrfunc(af);
+  if (m_capacity == 0) {
+    return NULL;
+  }
+
+  string arrmeta;
+  size_t hash = gather_arrmeta(nsrc, src_tp, src_arrmeta, arrmeta);
+  for (list<unique_ptr<cached_ckernel>>::iterator it = m_entries.begin();
+       it != m_entries.end(); ++it) {
+    cached_ckernel *ck = it->get();
+    if (ck->hash == hash && ck->src_arrmeta == arrmeta &&
+        ck->dst_tp == dst_tp &&
+        ck->src_tp.size() == static_cast<size_t>(nsrc) &&
+        equal(ck->src_tp.begin(), ck->src_tp.end(), src_tp) &&
+        same_eval_context(ck->ectx, *ectx)) {
+      if (it != m_entries.begin()) {
+        m_entries.splice(m_entries.begin(), m_entries, it);
+      }
+      ++m_hits;
+      return ck;
+    }
+  }
+
+  ++m_misses;
+  return NULL;
+}
+
+cached_ckernel *arrfunc_ckernel_cache::instantiate(
+    const nd::arrfunc &af, const ndt::type &dst_tp, const char *dst_arrmeta,
+    intptr_t nsrc, const ndt::type *src_tp, const char *const *src_arrmeta,
+    const eval::eval_context *ectx)
+{
+  check_arrfunc(af);
+
+  unique_ptr<cached_ckernel> ck(new cached_ckernel);
+  ck->dst_tp = dst_tp;
+  ck->src_tp.assign(src_tp, src_tp + nsrc);
+  ck->hash = gather_arrmeta(nsrc, src_tp, src_arrmeta, ck->src_arrmeta);
+  ck->ectx = *ectx;
+
+  // Instantiate with arrmeta owned by the entry, since the arrays
+  // passed in here are freed while the ckernel stays cached
+  ck->arrmeta_copies.resize(nsrc + 1);
+  const char *dst_arrmeta_copy =
+      copy_arrmeta(dst_tp, dst_arrmeta, ck->arrmeta_copies[0]);
+  vector<const char *> src_arrmeta_copy(nsrc);
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    src_arrmeta_copy[i] =
+        copy_arrmeta(src_tp[i], src_arrmeta[i], ck->arrmeta_copies[i + 1]);
+  }
+
+  const arrfunc_type_data *af_data = af.get();
+  af_data->instantiate(af_data, af.get_type(), NULL, &ck->ckb, 0, dst_tp,
+                       dst_arrmeta_copy, nsrc, src_tp,
+                       nsrc > 0 ? &src_arrmeta_copy[0] : NULL,
+                       kernel_request_single, ectx, nd::array(),
+                       map<nd::string, ndt::type>());
+
+  shrink_to(m_capacity > 0 ? m_capacity - 1 : 0);
+  m_entries.push_front(std::move(ck));
+  return m_entries.front().get();
+}
+
+void arrfunc_ckernel_cache::clear()
+{
+  shrink_to(0);
+  m_hits = m_misses = m_evictions = 0;
+}
+
+void arrfunc_ckernel_cache::set_capacity(size_t capacity)
+{
+  m_capacity = capacity;
+  shrink_to(m_capacity);
+}
+
+arrfunc_ckernel_cache *pydynd::get_arrfunc_ckernel_cache(PyObject *af_obj)
+{
+  WArrFunc *af = reinterpret_cast<WArrFunc *>(af_obj);
+  if (af->ckernel_cache == NULL) {
+    af->ckernel_cache = new arrfunc_ckernel_cache;
+  }
+  return af->ckernel_cache;
+}
+
+void pydynd::free_arrfunc_ckernel_cache(PyObject *af_obj)
+{
+  WArrFunc *af = reinterpret_cast<WArrFunc *>(af_obj);
+  delete af->ckernel_cache;
+  af->ckernel_cache = NULL;
+}
+
+PyObject *pydynd::arrfunc_ckernel_cache_info(PyObject *af_obj)
+{
+  if (!WArrFunc_Check(af_obj)) {
+    throw invalid_argument("expected an nd.arrfunc object");
+  }
+  const arrfunc_ckernel_cache *cache = get_arrfunc_ckernel_cache(af_obj);
+  pyobject_ownref result(PyDict_New());
+  pyobject_ownref value(PyLong_FromSize_t(cache->get_hits()));
+  if (PyDict_SetItemString(result.get(), "hits", value.get()) < 0) {
+    throw exception();
+  }
+  value.reset(PyLong_FromSize_t(cache->get_misses()));
+  if (PyDict_SetItemString(result.get(), "misses", value.get()) < 0) {
+    throw exception();
+  }
+  value.reset(PyLong_FromSize_t(cache->get_evictions()));
+  if (PyDict_SetItemString(result.get(), "evictions", value.get()) < 0) {
+    throw exception();
+  }
+  value.reset(PyLong_FromSize_t(cache->size()));
+  if (PyDict_SetItemString(result.get(), "size", value.get()) < 0) {
+    throw exception();
+  }
+  value.reset(PyLong_FromSize_t(cache->get_capacity()));
+  if (PyDict_SetItemString(result.get(), "capacity", value.get()) < 0) {
+    throw exception();
+  }
+  return result.release();
+}
+
+void pydynd::arrfunc_ckernel_cache_clear(PyObject *af_obj)
+{
+  if (!WArrFunc_Check(af_obj)) {
+    throw invalid_argument("expected an nd.arrfunc object");
+  }
+  get_arrfunc_ckernel_cache(af_obj)->clear();
+}
+
+void pydynd::arrfunc_ckernel_cache_set_capacity(PyObject *af_obj,
+                                                PyObject *capacity_obj)
+{
+  if (!WArrFunc_Check(af_obj)) {
+    throw invalid_argument("expected an nd.arrfunc object");
+  }
+  get_arrfunc_ckernel_cache(af_obj)->set_capacity(
+      pyobject_as_size_t(capacity_obj));
+}
@@ -18,6 +18,8 @@
 #include <exception_translation.hpp>
 #include <array_assign_from_py.hpp>
 #include <kernels/apply_pyobject_kernel.hpp>
+#include <kernels/apply_cfunc_kernel.hpp>
+#include <ctypes_interop.hpp>
 
 using namespace std;
 using namespace pydynd;
@@ -35,3 +37,110 @@ dynd::nd::arrfunc pydynd::nd::functional::apply(PyObject *instantiate_pyfunc,
   Py_INCREF(instantiate_pyfunc);
   return arrfunc::make<apply_pyobject_kernel>(proto, instantiate_pyfunc, 0);
 }
+
+template <typename T>
+static dynd::nd::arrfunc make_apply_cfunc(const ndt::type &proto,
+                                          intptr_t nsrc,
+                                          const std::shared_ptr<cfunc_data> &data)
+{
+  switch (nsrc) {
+  case 1:
+    return arrfunc::make<apply_cfunc_kernel<T, T>>(proto, data, 0);
+  case 2:
+    return arrfunc::make<apply_cfunc_kernel<T, T, T>>(proto, data, 0);
+  default:
+    return arrfunc::make<apply_cfunc_kernel<T, T, T, T>>(proto, data, 0);
+  }
+}
+
+dynd::nd::arrfunc pydynd::nd::functional::apply_cfunc(PyObject *cfunc)
+{
+  if (!PyObject_IsInstance(cfunc, ctypes.PyCFuncPtrType_Type)) {
+    throw type_error("creating a dynd arrfunc from a C function requires a "
+                     "ctypes function pointer");
+  }
+  PyCFuncPtrObject *cf = reinterpret_cast<PyCFuncPtrObject *>(cfunc);
+  calling_convention_t cc = get_ctypes_calling_convention(cf);
+  ndt::type ret_tp;
+  vector<ndt::type> param_tp;
+  get_ctypes_signature(cf, ret_tp, param_tp);
+  ndt::type proto = ndt::make_arrfunc(ndt::make_tuple(param_tp), ret_tp);
+
+  intptr_t nsrc = param_tp.size();
+  bool supported = cc == cdecl_callconv && nsrc >= 1 && nsrc <= 3;
+  for (intptr_t i = 0; i < nsrc; ++i) {
+    supported = supported && param_tp[i] == ret_tp;
+  }
+  if (supported) {
+    // ctypes stores the function pointer in the object's buffer
+    std::shared_ptr<cfunc_data> data(
+        new cfunc_data(cfunc, *reinterpret_cast<void (**)()>(cf->b_ptr)));
+    switch (ret_tp.get_type_id()) {
+    case int32_type_id:
+      return make_apply_cfunc<int32_t>(proto, nsrc, data);
+    case int64_type_id:
+      return make_apply_cfunc<int64_t>(proto, nsrc, data);
+    case uint32_type_id:
+      return make_apply_cfunc<uint32_t>(proto, nsrc, data);
+    case uint64_type_id:
+      return make_apply_cfunc<uint64_t>(proto, nsrc, data);
+    case float32_type_id:
+      return make_apply_cfunc<float>(proto, nsrc, data);
+    case float64_type_id:
+      return make_apply_cfunc<double>(proto, nsrc, data);
+    default:
+      break;
+    }
+  }
+
+  stringstream ss;
+  ss << "cannot call a C function with prototype " << proto
+     << " natively, its parameters and return must all be the same "
+        "int32, int64, uint32, uint64, float32 or float64 type";
+  throw type_error(ss.str());
+}
+
+dynd::nd::arrfunc
+pydynd::nd::functional::apply_strided_cfunc(PyObject *address, PyObject *owner,
+                                            const ndt::type &proto)
+{
+  if (proto.get_type_id() != arrfunc_type_id) {
+    stringstream ss;
+    ss << "creating a dynd arrfunc from a strided C function requires a "
+          "function prototype, was given type " << proto;
+    throw type_error(ss.str());
+  }
+  const ndt::arrfunc_type *af_tp = proto.extended<ndt::arrfunc_type>();
+  intptr_t nsrc = af_tp->get_npos();
+  if (nsrc > apply_strided_cfunc_kernel::max_nsrc) {
+    stringstream ss;
+    ss << "a strided C function may take at most "
+       << apply_strided_cfunc_kernel::max_nsrc << " parameters, prototype "
+       << proto << " has " << nsrc;
+    throw type_error(ss.str());
+  }
+  for (intptr_t i = -1; i < nsrc; ++i) {
+    const ndt::type &tp =
+        (i < 0) ? af_tp->get_return_type() : af_tp->get_pos_type(i);
+    if (tp.is_symbolic() || tp.get_arrmeta_size() > 0) {
+      stringstream ss;
+      ss << "a strided C function receives no arrmeta, so can't take "
+            "type " << tp << " in prototype " << proto;
+      throw type_error(ss.str());
+    }
+  }
+
+  void *ptr = PyLong_AsVoidPtr(address);
+  if (ptr == NULL) {
+    if (PyErr_Occurred()) {
+      throw exception();
+    }
+    throw invalid_argument("the address of a strided C function is NULL");
+  }
+  // Converting an object pointer to a function pointer is only
+  // conditionally supported, so go through an integer
+  void (*funcptr)() = reinterpret_cast<void (*)()>(
+      reinterpret_cast<uintptr_t>(ptr));
+  std::shared_ptr<cfunc_data> data(new cfunc_data(owner, funcptr));
+  return arrfunc::make<apply_strided_cfunc_kernel>(proto, data, 0);
+}
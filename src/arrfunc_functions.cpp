@@ -11,6 +11,11 @@
 #include "utility_functions.hpp"
 #include "numpy_interop.hpp"
 #include "arrfunc_from_pyfunc.hpp"
+#include "arrfunc_ckernel_cache.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <limits>
 
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/base_dim_type.hpp>
@@ -36,6 +41,250 @@ void pydynd::init_w_arrfunc_typeobject(PyObject *type)
   WArrFunc_Type = (PyTypeObject *)type;
 }
 
+namespace {
+
+// The number of positional arguments handled by the scalar fast path
+const intptr_t max_fast_args = 8;
+
+// Stack storage for one builtin scalar argument
+union builtin_scalar_buffer {
+  char data[16];
+  int64_t i64;
+  double f64;
+};
+
+template <typename T>
+bool pyint_to_builtin(long long v, char *out)
+{
+  if (std::numeric_limits<T>::is_signed) {
+    if (v < static_cast<long long>(std::numeric_limits<T>::min()) ||
+        v > static_cast<long long>(std::numeric_limits<T>::max())) {
+      return false;
+    }
+  } else if (v < 0 || static_cast<unsigned long long>(v) >
+                          static_cast<unsigned long long>(
+                              std::numeric_limits<T>::max())) {
+    return false;
+  }
+  *reinterpret_cast<T *>(out) = static_cast<T>(v);
+  return true;
+}
+
+/**
+ * Converts a Python bool, int, or float directly into a builtin value,
+ * for the cases where the conversion is exact (or only rounds a float,
+ * which the default error mode allows). Returns false, with no Python
+ * error set, for anything else, so that the caller can take the
+ * general path and get the usual errors.
+ */
+bool pyscalar_to_builtin(PyObject *obj, type_id_t tid, char *out,
+                         const eval::eval_context *ectx)
+{
+  if (PyBool_Check(obj)) {
+    if (tid != bool_type_id) {
+      return false;
+    }
+    *reinterpret_cast<dynd_bool *>(out) = (obj == Py_True);
+    return true;
+  } else if (PyFloat_Check(obj)) {
+    double v = PyFloat_AS_DOUBLE(obj);
+    if (tid == float64_type_id) {
+      *reinterpret_cast<double *>(out) = v;
+      return true;
+    } else if (tid == float32_type_id) {
+      float f = static_cast<float>(v);
+      if (ectx->errmode != assign_error_nocheck) {
+        if (ectx->errmode == assign_error_inexact
+                ? static_cast<double>(f) != v
+                : (std::fabs(v) > FLT_MAX && !std::isinf(v))) {
+          return false;
+        }
+      }
+      *reinterpret_cast<float *>(out) = f;
+      return true;
+    }
+    return false;
+  }
+#if PY_VERSION_HEX < 0x03000000
+  else if (PyLong_Check(obj) || PyInt_Check(obj)) {
+#else
+  else if (PyLong_Check(obj)) {
+#endif
+    int overflow = 0;
+    long long v = PyLong_AsLongLongAndOverflow(obj, &overflow);
+    if (overflow != 0 || (v == -1 && PyErr_Occurred())) {
+      PyErr_Clear();
+      return false;
+    }
+    switch (tid) {
+    case int8_type_id:
+      return pyint_to_builtin<int8_t>(v, out);
+    case int16_type_id:
+      return pyint_to_builtin<int16_t>(v, out);
+    case int32_type_id:
+      return pyint_to_builtin<int32_t>(v, out);
+    case int64_type_id:
+      return pyint_to_builtin<int64_t>(v, out);
+    case uint8_type_id:
+      return pyint_to_builtin<uint8_t>(v, out);
+    case uint16_type_id:
+      return pyint_to_builtin<uint16_t>(v, out);
+    case uint32_type_id:
+      return pyint_to_builtin<uint32_t>(v, out);
+    case uint64_type_id:
+      return pyint_to_builtin<uint64_t>(v, out);
+    case float32_type_id:
+      // Only integers which float32 represents exactly
+      if (v < -(1LL << 24) || v > (1LL << 24)) {
+        return false;
+      }
+      *reinterpret_cast<float *>(out) = static_cast<float>(v);
+      return true;
+    case float64_type_id:
+      if (v < -(1LL << 53) || v > (1LL << 53)) {
+        return false;
+      }
+      *reinterpret_cast<double *>(out) = static_cast<double>(v);
+      return true;
+    default:
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * Evaluates the arrfunc into a new array of its return type using a
+ * ckernel from the object's ckernel cache, instantiating it on a miss.
+ * The caller has checked that the types qualify for caching.
+ *
+ * Returns false if the cache is disabled, or the cached ckernel is
+ * already executing, in which case nothing has been evaluated.
+ */
+bool call_cached_ckernel(PyObject *af_obj, intptr_t narg,
+                         const ndt::type *src_tp,
+                         const char *const *src_arrmeta, char *const *src_data,
+                         const eval::eval_context *ectx, dynd::nd::array &out)
+{
+  const dynd::nd::arrfunc &af = ((WArrFunc *)af_obj)->v;
+  arrfunc_ckernel_cache *cache = get_arrfunc_ckernel_cache(af_obj);
+  if (!cache->enabled()) {
+    return false;
+  }
+
+  const ndt::type &dst_tp = af.get_type()->get_return_type();
+  dynd::nd::array result = dynd::nd::empty(dst_tp);
+  cached_ckernel *ck =
+      cache->find(af, dst_tp, narg, src_tp, src_arrmeta, ectx);
+  if (ck == NULL) {
+    ck = cache->instantiate(af, dst_tp, result.get_arrmeta(), narg, src_tp,
+                            src_arrmeta, ectx);
+  } else if (ck->in_use) {
+    return false;
+  }
+
+  {
+    cached_ckernel_use use(ck);
+    ck->get_single()(result.get_readwrite_originptr(), src_data,
+                     ck->ckb.get());
+  }
+  out = result;
+  return true;
+}
+
+/**
+ * The fast path of arrfunc_call for an arrfunc whose signature is made
+ * only of builtin types, called with Python scalars or 0-d arrays of
+ * exactly the parameter types. The arguments are converted into stack
+ * buffers instead of 0-d nd::arrays, and the single ckernel is taken
+ * from the arrfunc's ckernel cache, so a repeated call neither
+ * allocates arguments nor instantiates.
+ *
+ * Returns false if the call is not eligible, in which case nothing
+ * has been evaluated.
+ */
+bool arrfunc_call_scalars(PyObject *af_obj, PyObject *args_obj,
+                          const eval::eval_context *ectx,
+                          dynd::nd::array &out)
+{
+  const dynd::nd::arrfunc &af = ((WArrFunc *)af_obj)->v;
+  const ndt::arrfunc_type *af_tp = af.get_type();
+  intptr_t narg = PyTuple_GET_SIZE(args_obj);
+  if (narg > max_fast_args || narg != af_tp->get_npos() ||
+      af_tp->get_nkwd() != 0) {
+    return false;
+  }
+  const ndt::type &dst_tp = af_tp->get_return_type();
+  if (!dst_tp.is_builtin()) {
+    return false;
+  }
+
+  builtin_scalar_buffer buffers[max_fast_args];
+  char *src_data[max_fast_args];
+  for (intptr_t i = 0; i < narg; ++i) {
+    const ndt::type &param_tp = af_tp->get_pos_type(i);
+    if (!param_tp.is_builtin()) {
+      return false;
+    }
+    PyObject *arg = PyTuple_GET_ITEM(args_obj, i);
+    if (WArray_Check(arg)) {
+      // A 0-d array of the exact type is used in place
+      const dynd::nd::array &a = ((WArray *)arg)->v;
+      if (a.is_null() || a.get_type() != param_tp) {
+        return false;
+      }
+      src_data[i] = const_cast<char *>(a.get_readonly_originptr());
+    } else if (pyscalar_to_builtin(arg, param_tp.get_type_id(),
+                                   buffers[i].data, ectx)) {
+      src_data[i] = buffers[i].data;
+    } else {
+      return false;
+    }
+  }
+
+  const char *src_arrmeta[max_fast_args] = {NULL};
+  return call_cached_ckernel(af_obj, narg, af_tp->get_pos_types_raw(),
+                             src_arrmeta, src_data, ectx, out);
+}
+
+/**
+ * The cached path of arrfunc_call for array arguments. It applies when
+ * there are no keyword arguments, the arrfunc's signature is concrete,
+ * and the arguments have exactly the parameter types, so that the
+ * ckernel can be instantiated without resolving any types.
+ */
+bool arrfunc_call_arrays(PyObject *af_obj,
+                         const std::vector<dynd::nd::array> &args,
+                         const eval::eval_context *ectx,
+                         dynd::nd::array &out)
+{
+  const dynd::nd::arrfunc &af = ((WArrFunc *)af_obj)->v;
+  const ndt::arrfunc_type *af_tp = af.get_type();
+  intptr_t narg = static_cast<intptr_t>(args.size());
+  if (narg > max_fast_args || narg != af_tp->get_npos() ||
+      af_tp->get_nkwd() != 0 ||
+      !arrfunc_ckernel_cache::is_cacheable_type(af_tp->get_return_type())) {
+    return false;
+  }
+
+  const char *src_arrmeta[max_fast_args];
+  char *src_data[max_fast_args];
+  for (intptr_t i = 0; i < narg; ++i) {
+    const ndt::type &param_tp = af_tp->get_pos_type(i);
+    if (args[i].get_type() != param_tp ||
+        !arrfunc_ckernel_cache::is_cacheable_type(param_tp)) {
+      return false;
+    }
+    src_arrmeta[i] = args[i].get_arrmeta();
+    src_data[i] = const_cast<char *>(args[i].get_readonly_originptr());
+  }
+
+  return call_cached_ckernel(af_obj, narg, af_tp->get_pos_types_raw(),
+                             src_arrmeta, src_data, ectx, out);
+}
+
+} // anonymous namespace
+
 PyObject *pydynd::arrfunc_call(PyObject *af_obj, PyObject *args_obj,
                                PyObject *kwds_obj, PyObject *ectx_obj)
 {
@@ -60,6 +309,13 @@ PyObject *pydynd::arrfunc_call(PyObject *af_obj, PyObject *args_obj,
   }
   const eval::eval_context *ectx = eval_context_from_pyobj(ectx_obj);
 
+  if (PyDict_Size(kwds_obj) == 0) {
+    dynd::nd::array result;
+    if (arrfunc_call_scalars(af_obj, args_obj, ectx, result)) {
+      return wrap_array(result);
+    }
+  }
+
   // Convert args into nd::arrays
   intptr_t narg = PyTuple_Size(args_obj);
   std::vector<dynd::nd::array> arg_values(narg);
@@ -70,6 +326,13 @@ PyObject *pydynd::arrfunc_call(PyObject *af_obj, PyObject *args_obj,
 
   // Convert kwds into nd::arrays
   intptr_t nkwd = PyDict_Size(kwds_obj);
+  if (nkwd == 0) {
+    dynd::nd::array result;
+    if (arrfunc_call_arrays(af_obj, arg_values, ectx, result)) {
+      return wrap_array(result);
+    }
+  }
+
   vector<string> kwd_names_strings(nkwd);
   std::vector<const char *> kwd_names(nkwd);
   std::vector<dynd::nd::array> kwd_values(nkwd);
@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <Python.h>
+
+#include <string>
+
+#include "ckernel_builder_functions.hpp"
+#include "ctypes_interop.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+host_ckernel_builder *pydynd::ckernel_builder_new()
+{
+  return new host_ckernel_builder();
+}
+
+void pydynd::ckernel_builder_delete(host_ckernel_builder *ckb) { delete ckb; }
+
+void pydynd::ckernel_builder_reset(host_ckernel_builder *ckb) { ckb->reset(); }
+
+void pydynd::ckernel_builder_ensure_capacity(host_ckernel_builder *ckb,
+                                             intptr_t requested_capacity)
+{
+  ckb->ensure_capacity(requested_capacity);
+}
+
+void pydynd::ckernel_builder_ensure_capacity_leaf(host_ckernel_builder *ckb,
+                                                  intptr_t requested_capacity)
+{
+  ckb->ensure_capacity_leaf(requested_capacity);
+}
+
+// The ctypes kinds in ``ctypes`` are the base classes like _ctypes.Array,
+// so this checks the class of ``obj`` derives from ``kind``
+static bool is_ctypes_instance_of_kind(PyObject *obj, PyObject *kind)
+{
+  int result =
+      PyObject_IsSubclass(reinterpret_cast<PyObject *>(Py_TYPE(obj)), kind);
+  if (result < 0) {
+    throw exception();
+  }
+  return result != 0;
+}
+
+bool pydynd::ckernel_pointer_arg(PyObject *obj, uintptr_t *out)
+{
+  if (obj == Py_None) {
+    *out = 0;
+    return true;
+  }
+#if PY_VERSION_HEX < 0x03000000
+  if (PyInt_Check(obj)) {
+    *out = reinterpret_cast<uintptr_t>(PyLong_AsVoidPtr(obj));
+    return true;
+  }
+#endif
+  if (PyLong_Check(obj)) {
+    void *result = PyLong_AsVoidPtr(obj);
+    if (result == NULL && PyErr_Occurred()) {
+      // Let ctypes report it
+      PyErr_Clear();
+      return false;
+    }
+    *out = reinterpret_cast<uintptr_t>(result);
+    return true;
+  }
+
+  if (CDataObject_Check(obj)) {
+    CDataObject *cdata = reinterpret_cast<CDataObject *>(obj);
+    // Pointers pass their value, while arrays, structs and
+    // unions pass the address of their data
+    if (is_ctypes_instance_of_kind(obj, ctypes.PyCPointerType_Type) ||
+        is_ctypes_instance_of_kind(obj, ctypes.PyCFuncPtrType_Type)) {
+      *out = *reinterpret_cast<uintptr_t *>(cdata->b_ptr);
+      return true;
+    }
+    if (is_ctypes_instance_of_kind(obj, ctypes.PyCArrayType_Type) ||
+        is_ctypes_instance_of_kind(obj, ctypes.PyCStructType_Type) ||
+        is_ctypes_instance_of_kind(obj, ctypes.UnionType_Type)) {
+      *out = reinterpret_cast<uintptr_t>(cdata->b_ptr);
+      return true;
+    }
+    if (is_ctypes_instance_of_kind(obj, ctypes.PyCSimpleType_Type)) {
+      // Only c_void_p, c_char_p and c_wchar_p hold pointers
+      pyobject_ownref code(
+          PyObject_GetAttrString(reinterpret_cast<PyObject *>(Py_TYPE(obj)),
+                                 "_type_"));
+      string code_str = pystring_as_string(code.get());
+      if (code_str == "P" || code_str == "z" || code_str == "Z") {
+        *out = *reinterpret_cast<uintptr_t *>(cdata->b_ptr);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool pydynd::ckernel_index_arg(PyObject *obj, intptr_t *out)
+{
+#if PY_VERSION_HEX < 0x03000000
+  if (PyInt_Check(obj)) {
+    *out = PyInt_AS_LONG(obj);
+    return true;
+  }
+#endif
+  if (PyLong_Check(obj)) {
+    Py_ssize_t result = PyLong_AsSsize_t(obj);
+    if (result == -1 && PyErr_Occurred()) {
+      PyErr_Clear();
+      return false;
+    }
+    *out = result;
+    return true;
+  }
+  return false;
+}
+
+void pydynd::ckernel_call_single(uintptr_t ckp, uintptr_t dst, uintptr_t src)
+{
+  ckernel_prefix *self = reinterpret_cast<ckernel_prefix *>(ckp);
+  expr_single_t fn = self->get_function<expr_single_t>();
+  fn(reinterpret_cast<char *>(dst), reinterpret_cast<char *const *>(src),
+     self);
+}
+
+void pydynd::ckernel_call_strided(uintptr_t ckp, uintptr_t dst,
+                                  intptr_t dst_stride, uintptr_t src,
+                                  uintptr_t src_stride, intptr_t count)
+{
+  ckernel_prefix *self = reinterpret_cast<ckernel_prefix *>(ckp);
+  expr_strided_t fn = self->get_function<expr_strided_t>();
+  fn(reinterpret_cast<char *>(dst), dst_stride,
+     reinterpret_cast<char *const *>(src),
+     reinterpret_cast<const intptr_t *>(src_stride),
+     static_cast<size_t>(count), self);
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/types/base_expr_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+#include "datetime_parse.hpp"
+#include "parallel_eval.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+bool pydynd::is_string_to_datetime_column(const nd::array &n)
+{
+  if (n.is_null() || n.get_ndim() != 1 ||
+      n.get_type().get_type_id() != fixed_dim_type_id) {
+    return false;
+  }
+
+  const ndt::type &dt = n.get_dtype();
+  if (dt.get_type_id() != convert_type_id) {
+    return false;
+  }
+  const ndt::type &value_tp = dt.value_type();
+  if (value_tp.get_type_id() != date_type_id &&
+      (value_tp.get_type_id() != datetime_type_id ||
+       value_tp.extended<ndt::datetime_type>()->get_timezone() !=
+           tz_abstract)) {
+    return false;
+  }
+  const ndt::type &operand_tp =
+      dt.extended<ndt::base_expr_type>()->get_operand_type();
+  if (operand_tp.get_type_id() != string_type_id) {
+    return false;
+  }
+  string_encoding_t encoding =
+      operand_tp.extended<ndt::string_type>()->get_encoding();
+  return encoding == string_encoding_utf_8 || encoding == string_encoding_ascii;
+}
+
+nd::array
+pydynd::eval_string_to_datetime_column(const nd::array &n,
+                                       const eval::eval_context *ectx,
+                                       const eval_threading &threading)
+{
+  const ndt::type &dt = n.get_dtype();
+  const ndt::type &value_tp = dt.value_type();
+  const ndt::type &operand_tp =
+      dt.extended<ndt::base_expr_type>()->get_operand_type();
+  bool is_date = value_tp.get_type_id() == date_type_id;
+
+  // The arrmeta and data of the convert type are those of the strings
+  const fixed_dim_type_arrmeta *src_md =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(n.get_arrmeta());
+  const char *src_el_arrmeta = n.get_arrmeta() + sizeof(fixed_dim_type_arrmeta);
+  const char *src_data = n.get_readonly_originptr();
+  intptr_t size = src_md->dim_size, src_stride = src_md->stride;
+
+  nd::array result = nd::empty(n.get_type().get_canonical_type());
+  intptr_t dst_stride =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(result.get_arrmeta())
+          ->stride;
+  char *dst_data = result.get_readwrite_originptr();
+
+  parallel_for_chunks(
+      size, parallel_chunk_count(size, threading),
+      [&](intptr_t begin, intptr_t end) {
+        // The general conversion, made on the first string which
+        // isn't in one of the ISO 8601 forms
+        ckernel_builder<kernel_request_host> k;
+        expr_single_t fallback = NULL;
+        for (intptr_t i = begin; i < end; ++i) {
+          const char *src = src_data + i * src_stride;
+          char *dst = dst_data + i * dst_stride;
+          const string_type_data *s =
+              reinterpret_cast<const string_type_data *>(src);
+          if (is_date ? parse_iso8601_date(s->begin, s->end,
+                                           *reinterpret_cast<int32_t *>(dst))
+                      : parse_iso8601_datetime(
+                            s->begin, s->end,
+                            *reinterpret_cast<int64_t *>(dst))) {
+            continue;
+          }
+          if (fallback == NULL) {
+            make_assignment_kernel(NULL, NULL, &k, 0, value_tp, NULL,
+                                   operand_tp, src_el_arrmeta,
+                                   kernel_request_single, ectx, nd::array());
+            fallback = k.get()->get_function<expr_single_t>();
+          }
+          char *src_ptr = const_cast<char *>(src);
+          fallback(dst, &src_ptr, k.get());
+        }
+      });
+
+  return result;
+}
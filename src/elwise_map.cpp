@@ -6,6 +6,8 @@
 #include <Python.h>
 
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include <dynd/types/expr_type.hpp>
 #include <dynd/types/unary_expr_type.hpp>
@@ -25,34 +27,95 @@ using namespace dynd;
 using namespace pydynd;
 
 namespace {
+    /**
+     * The fixed_dim types given to the shell arrays for each
+     * chunk size seen, so that chunks of a size seen before
+     * only need a reference count increment.
+     */
+    class chunk_type_cache {
+        // The element types of the dst and src operands
+        vector<ndt::type> m_element_tp;
+        map<size_t, vector<ndt::type> > m_types;
+
+    public:
+        // Chunk sizes usually are the block size and the tails of
+        // dimensions, a handful of values
+        static const size_t max_size = 16;
+
+        explicit chunk_type_cache(const vector<ndt::type>& element_tp)
+            : m_element_tp(element_tp)
+        {
+        }
+
+        const vector<ndt::type>& get(size_t count)
+        {
+            map<size_t, vector<ndt::type> >::const_iterator it = m_types.find(count);
+            if (it != m_types.end()) {
+                return it->second;
+            }
+            if (m_types.size() >= max_size) {
+                m_types.clear();
+            }
+            vector<ndt::type>& types = m_types[count];
+            types.reserve(m_element_tp.size());
+            for (size_t i = 0; i != m_element_tp.size(); ++i) {
+                types.push_back(ndt::make_fixed_dim(count, m_element_tp[i]));
+            }
+            return types;
+        }
+    };
+
     struct pyobject_expr_kernel_extra {
         typedef pyobject_expr_kernel_extra extra_type;
 
         ckernel_prefix base;
         size_t src_count;
         PyObject *callable;
+        // The most elements passed to one call, or 0 for no limit
+        intptr_t blocksize;
+        // The dimension size the shell arrays currently have
+        size_t current_count;
+        chunk_type_cache *type_cache;
         // After this are 1 + src_count shell WArrays,
         // whose guts are replaced for each call of
         // the kernel
 
+        /**
+         * Gives the shell arrays a dimension of size ``count``,
+         * reusing cached types.
+         */
+        inline void set_chunk_size(size_t count)
+        {
+            if (count == current_count) {
+                return;
+            }
+            WArray **ndo = reinterpret_cast<WArray **>(this + 1);
+            const vector<ndt::type>& types = type_cache->get(count);
+            for (size_t i = 0; i != src_count + 1; ++i) {
+                array_preamble *preamble = ndo[i]->v.get_ndo();
+                base_type_decref(preamble->m_type);
+                preamble->m_type = ndt::type(types[i]).release();
+                reinterpret_cast<fixed_dim_type_arrmeta *>(
+                    ndo[i]->v.get_arrmeta())->dim_size = count;
+            }
+            current_count = count;
+        }
+
         inline PyObject *set_data_pointers(char *dst, const char * const *src)
         {
             WArray **ndo = reinterpret_cast<WArray **>(this + 1);
+            set_chunk_size(1);
             // Modify the temporary arrays to point at the data.
-            // The constructor sets the arrmeta to be a size-1 array,
-            // so no need to modify any of it.
             ndo[0]->v.get_ndo()->m_data_pointer = dst;
+            reinterpret_cast<fixed_dim_type_arrmeta *>(
+                ndo[0]->v.get_arrmeta())->stride = 0;
             for (size_t i = 0; i != src_count; ++i) {
                 ndo[i+1]->v.get_ndo()->m_data_pointer = const_cast<char *>(src[i]);
+                reinterpret_cast<fixed_dim_type_arrmeta *>(
+                    ndo[i+1]->v.get_arrmeta())->stride = 0;
             }
 
-            // Put all the arrays in a tuple
-            pyobject_ownref args(PyTuple_New(src_count + 1));
-            for (size_t i = 0; i != src_count + 1; ++i) {
-                Py_INCREF(ndo[i]);
-                PyTuple_SET_ITEM(args.get(), i, (PyObject *)ndo[i]);
-            }
-            return args.release();
+            return make_args_tuple();
         }
 
         inline PyObject *set_data_pointers(char *dst, intptr_t dst_stride,
@@ -60,30 +123,23 @@ namespace {
                         size_t count)
         {
             WArray **ndo = reinterpret_cast<WArray **>(this + 1);
-            fixed_dim_type_arrmeta *md;
+            set_chunk_size(count);
             // Modify the temporary arrays to point at the data.
             ndo[0]->v.get_ndo()->m_data_pointer = dst;
-            md = reinterpret_cast<fixed_dim_type_arrmeta *>(ndo[0]->v.get_arrmeta());
-            md->dim_size = count;
-            md->stride = dst_stride;
-            ndt::type tp = ndt::make_fixed_dim(
-                count, reinterpret_cast<const ndt::base_dim_type *>(
-                           ndo[0]->v.get_ndo()->m_type)->get_element_type());
-            base_type_decref(ndo[0]->v.get_ndo()->m_type);
-            ndo[0]->v.get_ndo()->m_type = tp.release();
+            reinterpret_cast<fixed_dim_type_arrmeta *>(
+                ndo[0]->v.get_arrmeta())->stride = dst_stride;
             for (size_t i = 0; i != src_count; ++i) {
                 ndo[i+1]->v.get_ndo()->m_data_pointer = const_cast<char *>(src[i]);
-                md = reinterpret_cast<fixed_dim_type_arrmeta *>(ndo[i+1]->v.get_arrmeta());
-                md->dim_size = count;
-                md->stride = src_stride[i];
-                tp = ndt::make_fixed_dim(
-                    count,
-                    reinterpret_cast<const ndt::base_dim_type *>(
-                        ndo[i+1]->v.get_ndo()->m_type)->get_element_type());
-                base_type_decref(ndo[i + 1]->v.get_ndo()->m_type);
-                ndo[i + 1]->v.get_ndo()->m_type = tp.release();
+                reinterpret_cast<fixed_dim_type_arrmeta *>(
+                    ndo[i+1]->v.get_arrmeta())->stride = src_stride[i];
             }
 
+            return make_args_tuple();
+        }
+
+        inline PyObject *make_args_tuple()
+        {
+            WArray **ndo = reinterpret_cast<WArray **>(this + 1);
             // Put all the arrays in a tuple
             pyobject_ownref args(PyTuple_New(src_count + 1));
             for (size_t i = 0; i != src_count + 1; ++i) {
@@ -139,6 +195,17 @@ namespace {
             e->verify_postcall_consistency(res.get());
         }
 
+        inline void call(char *dst, intptr_t dst_stride,
+                    const char *const *src, const intptr_t *src_stride,
+                    size_t count)
+        {
+            pyobject_ownref args(set_data_pointers(dst, dst_stride, src, src_stride, count));
+            // Call the function
+            pyobject_ownref res(PyObject_Call(callable, args.get(), NULL));
+            args.clear();
+            verify_postcall_consistency(res.get());
+        }
+
         static void strided(char *dst, intptr_t dst_stride,
                     char *const *src, const intptr_t *src_stride,
                     size_t count, ckernel_prefix *extra)
@@ -146,12 +213,23 @@ namespace {
             PyGILState_RAII pgs;
 
             extra_type *e = reinterpret_cast<extra_type *>(extra);
-            // Put all the arrays in a tuple
-            pyobject_ownref args(e->set_data_pointers(dst, dst_stride, src, src_stride, count));
-            // Call the function
-            pyobject_ownref res(PyObject_Call(e->callable, args.get(), NULL));
-            args.clear();
-            e->verify_postcall_consistency(res.get());
+            size_t blocksize = static_cast<size_t>(e->blocksize);
+            if (blocksize == 0 || count <= blocksize) {
+                e->call(dst, dst_stride, src, src_stride, count);
+                return;
+            }
+            // Hand the data to the callable in blocks
+            vector<const char *> src_block(src, src + e->src_count);
+            while (count > 0) {
+                size_t block_count = count < blocksize ? count : blocksize;
+                e->call(dst, dst_stride, src_block.empty() ? NULL : &src_block[0],
+                        src_stride, block_count);
+                dst += dst_stride * block_count;
+                for (size_t i = 0; i != e->src_count; ++i) {
+                    src_block[i] += src_stride[i] * block_count;
+                }
+                count -= block_count;
+            }
         }
 
         static void destruct(ckernel_prefix *extra)
@@ -162,6 +240,7 @@ namespace {
             WArray **ndo = reinterpret_cast<WArray **>(e + 1);
             size_t src_count = e->src_count;
             Py_XDECREF(e->callable);
+            delete e->type_cache;
             for (size_t i = 0; i != src_count + 1; ++i) {
                 Py_XDECREF(ndo[i]);
             }
@@ -173,18 +252,21 @@ class pyobject_elwise_expr_kernel_generator : public expr_kernel_generator {
     pyobject_ownref m_callable;
     ndt::type m_dst_tp;
     vector<ndt::type> m_src_tp;
+    intptr_t m_blocksize;
 public:
     pyobject_elwise_expr_kernel_generator(PyObject *callable,
-                    const ndt::type& dst_tp, const std::vector<ndt::type>& src_tp)
+                    const ndt::type& dst_tp, const std::vector<ndt::type>& src_tp,
+                    intptr_t blocksize)
         : expr_kernel_generator(true), m_callable(callable, true),
-                        m_dst_tp(dst_tp), m_src_tp(src_tp)
+                        m_dst_tp(dst_tp), m_src_tp(src_tp), m_blocksize(blocksize)
     {
     }
 
     pyobject_elwise_expr_kernel_generator(PyObject *callable,
-                    const ndt::type& dst_tp, const ndt::type& src_tp)
+                    const ndt::type& dst_tp, const ndt::type& src_tp,
+                    intptr_t blocksize)
         : expr_kernel_generator(true), m_callable(callable, true),
-                        m_dst_tp(dst_tp), m_src_tp(1)
+                        m_dst_tp(dst_tp), m_src_tp(1), m_blocksize(blocksize)
     {
         m_src_tp[0] = src_tp;
     }
@@ -239,6 +321,11 @@ public:
         e->src_count = src_count;
         e->callable = m_callable.get();
         Py_INCREF(e->callable);
+        e->blocksize = m_blocksize;
+        e->current_count = 1;
+        vector<ndt::type> element_tp(src_tp, src_tp + src_count);
+        element_tp.insert(element_tp.begin(), dst_tp);
+        e->type_cache = new chunk_type_cache(element_tp);
         // Create shell WArrays which are used to give the kernel data to Python
         fixed_dim_type_arrmeta *md;
         ndt::type dt = ndt::make_fixed_dim(1, dst_tp);
@@ -294,7 +381,7 @@ public:
 };
 
 static PyObject *unary_elwise_map(PyObject *n_obj, PyObject *callable,
-                PyObject *dst_type, PyObject *src_type)
+                PyObject *dst_type, PyObject *src_type, intptr_t blocksize)
 {
     nd::array n = array_from_py(n_obj, 0, false, &eval::default_eval_context);
     if (n.get_ndo() == NULL) {
@@ -314,13 +401,14 @@ static PyObject *unary_elwise_map(PyObject *n_obj, PyObject *callable,
     }
 
     ndt::type edt = ndt::make_unary_expr(dst_tp, src_tp,
-                    new pyobject_elwise_expr_kernel_generator(callable, dst_tp, src_tp.value_type()));
+                    new pyobject_elwise_expr_kernel_generator(callable, dst_tp, src_tp.value_type(),
+                                                              blocksize));
     nd::array result = n.replace_dtype(edt, src_tp.get_ndim());
     return wrap_array(result);
 }
 
 static PyObject *general_elwise_map(PyObject *n_list, PyObject *callable,
-                PyObject *dst_type, PyObject *src_type_list)
+                PyObject *dst_type, PyObject *src_type_list, intptr_t blocksize)
 {
     vector<nd::array> n(PyList_Size(n_list));
     for (size_t i = 0; i != n.size(); ++i) {
@@ -383,13 +471,14 @@ static PyObject *general_elwise_map(PyObject *n_list, PyObject *callable,
     // we can swap it in as the type
     ndt::type edt = ndt::make_expr(result_vdt,
                     result.get_type(),
-                    new pyobject_elwise_expr_kernel_generator(callable, dst_tp, src_tp));
+                    new pyobject_elwise_expr_kernel_generator(callable, dst_tp, src_tp,
+                                                              blocksize));
     edt.swap(result.get_ndo()->m_type);
     return wrap_array(std::move(result));
 }
 
 PyObject *pydynd::elwise_map(PyObject *n_obj, PyObject *callable,
-                PyObject *dst_type, PyObject *src_type)
+                PyObject *dst_type, PyObject *src_type, PyObject *blocksize_obj)
 {
     if (!PyList_Check(n_obj)) {
         PyErr_SetString(PyExc_TypeError, "First parameter to elwise_map, 'n', "
@@ -403,10 +492,20 @@ PyObject *pydynd::elwise_map(PyObject *n_obj, PyObject *callable,
             return NULL;
         }
     }
+    intptr_t blocksize = 0;
+    if (blocksize_obj != Py_None) {
+        blocksize = pyobject_as_index(blocksize_obj);
+        if (blocksize <= 0) {
+            PyErr_SetString(PyExc_ValueError, "The 'blocksize' parameter to "
+                            "elwise_map must be positive");
+            return NULL;
+        }
+    }
     if (PyList_Size(n_obj) == 1) {
         return unary_elwise_map(PyList_GET_ITEM(n_obj, 0), callable, dst_type,
-                        src_type == Py_None ? Py_None : PyList_GET_ITEM(src_type, 0));
+                        src_type == Py_None ? Py_None : PyList_GET_ITEM(src_type, 0),
+                        blocksize);
     } else {
-        return general_elwise_map(n_obj, callable, dst_type, src_type);
+        return general_elwise_map(n_obj, callable, dst_type, src_type, blocksize);
     }
 }
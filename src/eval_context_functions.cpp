@@ -12,12 +12,15 @@ using namespace pydynd;
 
 PyTypeObject *pydynd::WEvalContext_Type;
 
+eval_threading pydynd::default_eval_threading = factory_eval_threading;
+
 void pydynd::init_w_eval_context_typeobject(PyObject *type)
 {
     WEvalContext_Type = (PyTypeObject *)type;
 }
 
-static void modify_eval_context(eval::eval_context *ectx, PyObject *kwargs)
+static void modify_eval_context(eval::eval_context *ectx,
+                                eval_threading *threading, PyObject *kwargs)
 {
     if (!PyDict_Check(kwargs)) {
         throw invalid_argument(
@@ -33,6 +36,7 @@ static void modify_eval_context(eval::eval_context *ectx, PyObject *kwargs)
         if (PyObject_IsTrue(obj)) {
             // Reset to factory settings
             *ectx = eval::eval_context();
+            *threading = factory_eval_threading;
         }
         if (PyDict_DelItemString(kwargs, "reset") < 0) {
             throw runtime_error("");
@@ -82,6 +86,36 @@ static void modify_eval_context(eval::eval_context *ectx, PyObject *kwargs)
             throw runtime_error("");
         }
     }
+    // threads
+    obj = PyDict_GetItemString(kwargs, "threads");
+    if (obj != NULL) {
+        intptr_t threads = pyobject_as_index(obj);
+        if (threads < 0) {
+            stringstream ss;
+            ss << "nd.eval_context(): invalid threads value " << threads;
+            ss << ", must be 0 (one per hardware thread) or positive";
+            throw invalid_argument(ss.str());
+        }
+        threading->threads = threads;
+        if (PyDict_DelItemString(kwargs, "threads") < 0) {
+            throw runtime_error("");
+        }
+    }
+    // grainsize
+    obj = PyDict_GetItemString(kwargs, "grainsize");
+    if (obj != NULL) {
+        intptr_t grainsize = pyobject_as_index(obj);
+        if (grainsize < 1) {
+            stringstream ss;
+            ss << "nd.eval_context(): invalid grainsize value " << grainsize;
+            ss << ", must be positive";
+            throw invalid_argument(ss.str());
+        }
+        threading->grainsize = grainsize;
+        if (PyDict_DelItemString(kwargs, "grainsize") < 0) {
+            throw runtime_error("");
+        }
+    }
 
     // Verify that there are no more keyword arguments
     PyObject *key, *value;
@@ -95,24 +129,26 @@ static void modify_eval_context(eval::eval_context *ectx, PyObject *kwargs)
     }
 }
 
-eval::eval_context *pydynd::new_eval_context(PyObject *kwargs)
+eval::eval_context *pydynd::new_eval_context(PyObject *kwargs,
+                                             eval_threading *out_threading)
 {
     // Allocate the eval_context, copying eval::default_eval_context to start
     eval::eval_context ectx(eval::default_eval_context);
+    eval_threading threading = default_eval_threading;
 
     // Validate the kwargs is a non-empty dictionary
-    if (kwargs == NULL || kwargs == Py_None) {
-        return new eval::eval_context(ectx);
+    if (kwargs != NULL && kwargs != Py_None) {
+        modify_eval_context(&ectx, &threading, kwargs);
     }
 
-    modify_eval_context(&ectx, kwargs);
-
+    *out_threading = threading;
     return new eval::eval_context(ectx);
 }
 
 void pydynd::modify_default_eval_context(PyObject *kwargs)
 {
-    modify_eval_context(&eval::default_eval_context, kwargs);
+    modify_eval_context(&eval::default_eval_context, &default_eval_threading,
+                        kwargs);
 }
 
 PyObject *pydynd::get_eval_context_errmode(PyObject *ectx_obj)
@@ -173,7 +209,10 @@ PyObject *pydynd::get_eval_context_repr(PyObject *ectx_obj)
     ss << "nd.eval_context(errmode='" << ectx->errmode << "',\n";
     ss << "                cuda_device_errmode='" << ectx->cuda_device_errmode << "',\n";
     ss << "                date_parse_order='" << ectx->date_parse_order << "',\n";
-    ss << "                century_window=" << ectx->century_window << ")";
+    ss << "                century_window=" << ectx->century_window << ",\n";
+    const eval_threading &threading = ((WEvalContext *)ectx_obj)->threading;
+    ss << "                threads=" << threading.threads << ",\n";
+    ss << "                grainsize=" << threading.grainsize << ")";
 #if PY_VERSION_HEX < 0x03000000
     return PyString_FromString(ss.str().c_str());
 #else
@@ -0,0 +1,306 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <dynd/kernels/assignment_kernels.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/string_type.hpp>
+
+#include "factorize.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+namespace {
+
+inline uint64_t mix_hash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * Key traits for integer columns, the key is the value itself.
+ */
+template <typename T>
+struct int_key {
+  typedef T key_type;
+
+  static inline key_type get(const char *data)
+  {
+    return *reinterpret_cast<const T *>(data);
+  }
+  static inline uint64_t hash(key_type key)
+  {
+    return mix_hash(static_cast<uint64_t>(key));
+  }
+  static inline bool equal(key_type lhs, key_type rhs) { return lhs == rhs; }
+  static inline bool less(key_type lhs, key_type rhs) { return lhs < rhs; }
+};
+
+/**
+ * Key traits for string columns, the key points at the string data
+ * of the column.
+ */
+struct string_key {
+  typedef string_type_data key_type;
+
+  static inline key_type get(const char *data)
+  {
+    return *reinterpret_cast<const string_type_data *>(data);
+  }
+  static inline uint64_t hash(const key_type &key)
+  {
+    const char *s = key.begin;
+    size_t n = key.end - key.begin;
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ n;
+    for (; n >= 8; s += 8, n -= 8) {
+      uint64_t word;
+      memcpy(&word, s, 8);
+      h = mix_hash(h ^ word);
+    }
+    uint64_t word = 0;
+    memcpy(&word, s, n);
+    return mix_hash(h ^ word);
+  }
+  static inline bool equal(const key_type &lhs, const key_type &rhs)
+  {
+    return lhs.end - lhs.begin == rhs.end - rhs.begin &&
+           memcmp(lhs.begin, rhs.begin, lhs.end - lhs.begin) == 0;
+  }
+  static inline bool less(const key_type &lhs, const key_type &rhs)
+  {
+    size_t lhs_size = lhs.end - lhs.begin, rhs_size = rhs.end - rhs.begin;
+    int cmp = memcmp(lhs.begin, rhs.begin, min(lhs_size, rhs_size));
+    return cmp < 0 || (cmp == 0 && lhs_size < rhs_size);
+  }
+};
+
+/**
+ * An open addressing hash table with linear probing, mapping each
+ * distinct key to its category, the order in which it was first seen.
+ * The slots hold category + 1, so zero marks an empty slot.
+ */
+template <typename Traits>
+class category_table {
+  typedef typename Traits::key_type key_type;
+
+  vector<uint32_t> m_slots;
+  size_t m_mask;
+  vector<key_type> m_keys;
+  vector<uint64_t> m_hashes;
+  vector<intptr_t> m_first_index;
+
+  void grow()
+  {
+    vector<uint32_t> slots(m_slots.size() * 2, 0);
+    size_t mask = slots.size() - 1;
+    for (size_t i = 0; i < m_keys.size(); ++i) {
+      size_t slot = m_hashes[i] & mask;
+      while (slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      slots[slot] = static_cast<uint32_t>(i + 1);
+    }
+    m_slots.swap(slots);
+    m_mask = mask;
+  }
+
+public:
+  category_table() : m_slots(1024, 0), m_mask(1023) {}
+
+  uint32_t insert(const key_type &key, intptr_t index)
+  {
+    uint64_t h = Traits::hash(key);
+    size_t slot = h & m_mask;
+    for (;;) {
+      uint32_t cat = m_slots[slot];
+      if (cat == 0) {
+        break;
+      }
+      if (m_hashes[cat - 1] == h && Traits::equal(m_keys[cat - 1], key)) {
+        return cat - 1;
+      }
+      slot = (slot + 1) & m_mask;
+    }
+
+    if (m_keys.size() >= 0xffffffffu) {
+      throw overflow_error("nd.factorize: too many distinct values for a "
+                           "categorical type");
+    }
+    uint32_t cat = static_cast<uint32_t>(m_keys.size());
+    m_slots[slot] = cat + 1;
+    m_keys.push_back(key);
+    m_hashes.push_back(h);
+    m_first_index.push_back(index);
+    // Keep the load factor at or below one half
+    if (m_keys.size() * 2 > m_slots.size()) {
+      grow();
+    }
+    return cat;
+  }
+
+  size_t size() const { return m_keys.size(); }
+
+  /**
+   * Reorders the categories by sorting their keys, returning the
+   * new category of each old one.
+   */
+  vector<uint32_t> sort()
+  {
+    vector<uint32_t> order(m_keys.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = static_cast<uint32_t>(i);
+    }
+    const vector<key_type> &keys = m_keys;
+    std::sort(order.begin(), order.end(), [&keys](uint32_t lhs, uint32_t rhs) {
+      return Traits::less(keys[lhs], keys[rhs]);
+    });
+
+    vector<uint32_t> remap(order.size());
+    vector<intptr_t> first_index(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      remap[order[i]] = static_cast<uint32_t>(i);
+      first_index[i] = m_first_index[order[i]];
+    }
+    m_first_index.swap(first_index);
+    return remap;
+  }
+
+  const vector<intptr_t> &first_index() const { return m_first_index; }
+};
+
+template <typename T>
+inline void store_codes(char *dst, intptr_t dst_stride, const uint32_t *codes,
+                        intptr_t size)
+{
+  for (intptr_t i = 0; i < size; ++i, dst += dst_stride) {
+    *reinterpret_cast<T *>(dst) = static_cast<T>(codes[i]);
+  }
+}
+
+template <typename Traits>
+nd::array factorize_column(const nd::array &values, bool sort)
+{
+  const fixed_dim_type_arrmeta *src_md =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(values.get_arrmeta());
+  const char *src_el_arrmeta =
+      values.get_arrmeta() + sizeof(fixed_dim_type_arrmeta);
+  const char *src_data = values.get_readonly_originptr();
+  intptr_t size = src_md->dim_size, src_stride = src_md->stride;
+  const ndt::type &dt = values.get_dtype();
+
+  // Assign every element its category in one pass
+  category_table<Traits> table;
+  vector<uint32_t> codes(size);
+  {
+    PyGILRelease_RAII nogil;
+    const char *src = src_data;
+    for (intptr_t i = 0; i < size; ++i, src += src_stride) {
+      codes[i] = table.insert(Traits::get(src), i);
+    }
+    if (sort) {
+      vector<uint32_t> remap = table.sort();
+      for (intptr_t i = 0; i < size; ++i) {
+        codes[i] = remap[codes[i]];
+      }
+    }
+  }
+
+  // Copy the first occurrence of each category to make the categories
+  intptr_t ncats = static_cast<intptr_t>(table.size());
+  nd::array cats = nd::empty(ndt::make_fixed_dim(ncats, dt));
+  if (ncats > 0) {
+    ckernel_builder<kernel_request_host> k;
+    make_assignment_kernel(NULL, NULL, &k, 0, dt,
+                           cats.get_arrmeta() + sizeof(fixed_dim_type_arrmeta),
+                           dt, src_el_arrmeta, kernel_request_single,
+                           &eval::default_eval_context, nd::array());
+    expr_single_t fn = k.get()->get_function<expr_single_t>();
+    intptr_t cats_stride =
+        reinterpret_cast<const fixed_dim_type_arrmeta *>(cats.get_arrmeta())
+            ->stride;
+    char *dst = cats.get_readwrite_originptr();
+    const vector<intptr_t> &first_index = table.first_index();
+    for (intptr_t i = 0; i < ncats; ++i, dst += cats_stride) {
+      char *src = const_cast<char *>(src_data) + first_index[i] * src_stride;
+      fn(dst, &src, k.get());
+    }
+  }
+  cats.flag_as_immutable();
+
+  ndt::type cat_tp = ndt::make_categorical(cats);
+  nd::array result = nd::empty(ndt::make_fixed_dim(size, cat_tp));
+  intptr_t dst_stride =
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(result.get_arrmeta())
+          ->stride;
+  char *dst = result.get_readwrite_originptr();
+  switch (cat_tp.get_data_size()) {
+  case 1:
+    store_codes<uint8_t>(dst, dst_stride, codes.data(), size);
+    break;
+  case 2:
+    store_codes<uint16_t>(dst, dst_stride, codes.data(), size);
+    break;
+  default:
+    store_codes<uint32_t>(dst, dst_stride, codes.data(), size);
+    break;
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+nd::array pydynd::array_factorize(const nd::array &values, bool sort)
+{
+  nd::array a = values.eval();
+  if (a.get_ndim() != 1) {
+    throw invalid_argument("nd.factorize: require a one-dimensional array");
+  }
+
+  if (a.get_type().get_type_id() == fixed_dim_type_id) {
+    const ndt::type &dt = a.get_dtype();
+    switch (dt.get_type_id()) {
+    case int8_type_id:
+      return factorize_column<int_key<int8_t>>(a, sort);
+    case int16_type_id:
+      return factorize_column<int_key<int16_t>>(a, sort);
+    case int32_type_id:
+      return factorize_column<int_key<int32_t>>(a, sort);
+    case int64_type_id:
+      return factorize_column<int_key<int64_t>>(a, sort);
+    case uint8_type_id:
+      return factorize_column<int_key<uint8_t>>(a, sort);
+    case uint16_type_id:
+      return factorize_column<int_key<uint16_t>>(a, sort);
+    case uint32_type_id:
+      return factorize_column<int_key<uint32_t>>(a, sort);
+    case uint64_type_id:
+      return factorize_column<int_key<uint64_t>>(a, sort);
+    case string_type_id: {
+      string_encoding_t encoding =
+          dt.extended<ndt::string_type>()->get_encoding();
+      if (encoding == string_encoding_utf_8 ||
+          encoding == string_encoding_ascii) {
+        return factorize_column<string_key>(a, sort);
+      }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  // The general path, a sorted factor_categorical and an assignment
+  return a.ucast(ndt::factor_categorical(a)).eval();
+}
@@ -199,6 +199,20 @@ PyObject *pydynd::nd::functional::arrfunc_from_ufunc(PyObject *ufunc,
           data->param_count = nargs - 1;
           data->funcptr = uf->functions[i];
           data->ufunc_data = uf->data[i];
+          data->gil_safe = true;
+          for (intptr_t j = 0; j < nargs; ++j) {
+            // Back to the numpy convention "in, out"
+            int type_num = argtypes[j == nargs - 1 ? 0 : j + 1];
+            PyArray_Descr *dt = PyArray_DescrFromType(type_num);
+            if (dt == NULL) {
+              return NULL;
+            }
+            data->arg_size[j] = dt->elsize;
+            if (PyDataType_REFCHK(dt)) {
+              data->gil_safe = false;
+            }
+            Py_DECREF(dt);
+          }
           if (ckernel_acquires_gil) {
             return wrap_array(
                 arrfunc::make<scalar_ufunc_ck<true>>(self_tp, data, 0));
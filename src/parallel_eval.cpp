@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <dynd/types/base_expr_type.hpp>
+
+#include "parallel_eval.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+static bool is_thread_safe_expr(const ndt::type &dt)
+{
+  ndt::type tp = dt;
+  while (tp.get_kind() == expr_kind) {
+    switch (tp.get_type_id()) {
+    case convert_type_id:
+    case view_type_id:
+    case byteswap_type_id:
+      break;
+    default:
+      return false;
+    }
+    tp = tp.extended<ndt::base_expr_type>()->get_operand_type();
+  }
+  return true;
+}
+
+intptr_t pydynd::parallel_chunk_count(intptr_t size,
+                                      const eval_threading &threading)
+{
+  intptr_t threads = threading.threads;
+  if (threads == 0) {
+    threads = max<intptr_t>(thread::hardware_concurrency(), 1);
+  }
+  intptr_t grainsize = max<intptr_t>(threading.grainsize, 1);
+  return max<intptr_t>(min(threads, size / grainsize), 1);
+}
+
+intptr_t pydynd::parallel_eval_chunks(const nd::array &n,
+                                      const eval_threading &threading)
+{
+  if (threading.threads == 1 || n.is_null() ||
+      n.get_type().get_type_id() != fixed_dim_type_id) {
+    return 1;
+  }
+
+  ndt::type dt = n.get_dtype();
+  if (dt.get_kind() != expr_kind || !is_thread_safe_expr(dt)) {
+    return 1;
+  }
+  // The chunks would share the memory blocks of the result, for
+  // example to allocate var dimension elements, which isn't safe
+  // across threads
+  if ((n.get_type().get_canonical_type().get_flags() &
+       (type_flag_blockref | type_flag_destructor)) != 0) {
+    return 1;
+  }
+
+  return parallel_chunk_count(n.get_dim_size(), threading);
+}
+
+void pydynd::parallel_for_chunks(
+    intptr_t size, intptr_t nchunks,
+    const std::function<void(intptr_t, intptr_t)> &fn)
+{
+  if (nchunks <= 1) {
+    PyGILRelease_RAII nogil;
+    fn(0, size);
+    return;
+  }
+
+  vector<exception_ptr> errors(nchunks);
+  {
+    PyGILRelease_RAII nogil;
+
+    auto run_chunk = [&](intptr_t i) {
+      try {
+        fn(size * i / nchunks, size * (i + 1) / nchunks);
+      }
+      catch (...) {
+        errors[i] = current_exception();
+      }
+    };
+
+    vector<thread> workers;
+    workers.reserve(nchunks - 1);
+    for (intptr_t i = 1; i < nchunks; ++i) {
+      try {
+        workers.push_back(thread(run_chunk, i));
+      }
+      catch (const system_error &) {
+        // Out of threads, do this range on the calling thread
+        run_chunk(i);
+      }
+    }
+    run_chunk(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+      workers[i].join();
+    }
+  }
+
+  for (intptr_t i = 0; i < nchunks; ++i) {
+    if (errors[i]) {
+      rethrow_exception(errors[i]);
+    }
+  }
+}
+
+void pydynd::parallel_eval_assign(const nd::array &dst, const nd::array &src,
+                                  const eval::eval_context *ectx,
+                                  intptr_t nchunks)
+{
+  intptr_t size = dst.get_dim_size();
+  // Make the views of each range while holding the GIL
+  vector<nd::array> dst_chunks(nchunks), src_chunks(nchunks);
+  for (intptr_t i = 0; i < nchunks; ++i) {
+    intptr_t begin = size * i / nchunks, end = size * (i + 1) / nchunks;
+    dst_chunks[i] = dst(irange(begin, end));
+    src_chunks[i] = src(irange(begin, end));
+  }
+
+  parallel_for_chunks(nchunks, nchunks, [&](intptr_t begin, intptr_t end) {
+    for (intptr_t i = begin; i < end; ++i) {
+      dst_chunks[i].val_assign(src_chunks[i], ectx);
+    }
+  });
+}
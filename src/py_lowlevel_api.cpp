@@ -13,6 +13,7 @@
 #include <dynd/func/rolling.hpp>
 #include <dynd/kernels/reduction_kernels.hpp>
 #include <dynd/func/take.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 
 #include "py_lowlevel_api.hpp"
 #include "numpy_ufunc_kernel.hpp"
@@ -379,8 +380,133 @@ const py_lowlevel_api_t py_lowlevel_api = {
     &make_rolling_arrfunc,
     &make_builtin_mean1d_arrfunc,
     &make_take_arrfunc};
+
+static_assert(PYDYND_READ_ACCESS == dynd::nd::read_access_flag &&
+                  PYDYND_WRITE_ACCESS == dynd::nd::write_access_flag &&
+                  PYDYND_IMMUTABLE_ACCESS ==
+                      dynd::nd::immutable_access_flag,
+              "the C-API access flags must match dynd's");
+
+int capi_array_check(PyObject *obj) { return WArray_Check(obj) ? 1 : 0; }
+
+void capi_no_free(void *DYND_UNUSED(owner)) {}
+
+/**
+ * Makes the full type of an array from the type given to the C-API,
+ * adding ``ndim`` fixed dimensions.
+ */
+dynd::ndt::type capi_array_type(PyObject *tp_obj, intptr_t ndim,
+                                const intptr_t *shape)
+{
+  dynd::ndt::type tp = make_ndt_type_from_pyobject(tp_obj);
+  if (ndim < 0) {
+    stringstream ss;
+    ss << "Cannot create a dynd array with " << ndim << " dimensions";
+    throw invalid_argument(ss.str());
+  } else if (ndim > 0) {
+    tp = dynd::ndt::make_fixed_dim(ndim, shape, tp);
+  }
+  return tp;
+}
+
+PyObject *capi_array_from_buffer(PyObject *tp_obj, intptr_t ndim,
+                                 const intptr_t *shape,
+                                 const intptr_t *strides, char *data,
+                                 void *owner, void (*free_owner)(void *),
+                                 uint32_t access_flags)
+{
+  try {
+    dynd::ndt::type tp = capi_array_type(tp_obj, ndim, shape);
+    if (tp.is_symbolic()) {
+      stringstream ss;
+      ss << "Cannot create a dynd array with symbolic type " << tp;
+      throw type_error(ss.str());
+    }
+    if (tp.get_flags() & dynd::type_flag_destructor) {
+      stringstream ss;
+      ss << "Cannot view raw memory using dynd type " << tp;
+      throw type_error(ss.str());
+    }
+    if ((access_flags & PYDYND_READ_ACCESS) == 0 ||
+        (access_flags & ~(PYDYND_READ_ACCESS | PYDYND_WRITE_ACCESS |
+                          PYDYND_IMMUTABLE_ACCESS)) != 0 ||
+        ((access_flags & PYDYND_WRITE_ACCESS) &&
+         (access_flags & PYDYND_IMMUTABLE_ACCESS))) {
+      stringstream ss;
+      ss << "Invalid access flags " << access_flags
+         << " for a dynd array";
+      throw invalid_argument(ss.str());
+    }
+
+    dynd::nd::array result(make_array_memory_block(tp.get_arrmeta_size()));
+    // Default-construct the arrmeta WITHOUT allocating memory blocks
+    // for the blockref types, then apply the strides given
+    if (tp.get_arrmeta_size() > 0) {
+      tp.extended()->arrmeta_default_construct(result.get_ndo()->get_arrmeta(),
+                                               false);
+    }
+    if (strides != NULL) {
+      // The arrmeta of nested fixed dims is laid out one after another
+      dynd::fixed_dim_type_arrmeta *md =
+          reinterpret_cast<dynd::fixed_dim_type_arrmeta *>(
+              result.get_ndo()->get_arrmeta());
+      for (intptr_t i = 0; i < ndim; ++i) {
+        md[i].stride = strides[i];
+      }
+    }
+    tp.swap(result.get_ndo()->m_type);
+    result.get_ndo()->m_data_pointer = data;
+    memory_block_ptr owner_memblock = make_external_memory_block(
+        owner, free_owner != NULL ? free_owner : &capi_no_free);
+    result.get_ndo()->m_data_reference = owner_memblock.release();
+    result.get_ndo()->m_flags = access_flags;
+    return wrap_array(std::move(result));
+  }
+  catch (...) {
+    translate_exception();
+    return NULL;
+  }
+}
+
+PyObject *capi_array_empty(PyObject *tp_obj, intptr_t ndim,
+                           const intptr_t *shape)
+{
+  try {
+    return wrap_array(dynd::nd::empty(capi_array_type(tp_obj, ndim, shape)));
+  }
+  catch (...) {
+    translate_exception();
+    return NULL;
+  }
+}
+
+char *capi_array_data(PyObject *a)
+{
+  return ((WArray *)a)->v.get_ndo()->m_data_pointer;
+}
+
+const char *capi_array_arrmeta(PyObject *a)
+{
+  return ((WArray *)a)->v.get_arrmeta();
+}
+
+uint32_t capi_array_access_flags(PyObject *a)
+{
+  return ((WArray *)a)->v.get_access_flags();
+}
+
+const pydynd_capi_t capi = {PYDYND_CAPI_VERSION, &capi_array_check,
+                            &capi_array_from_buffer, &capi_array_empty,
+                            &capi_array_data, &capi_array_arrmeta,
+                            &capi_array_access_flags};
 } // anonymous namespace
 
+PyObject *pydynd::make_capi_capsule()
+{
+  return PyCapsule_New(const_cast<pydynd_capi_t *>(&capi), PYDYND_CAPI_NAME,
+                       NULL);
+}
+
 extern "C" const void *dynd_get_py_lowlevel_api()
 {
   return reinterpret_cast<const void *>(&py_lowlevel_api);
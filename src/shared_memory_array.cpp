@@ -0,0 +1,321 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <Python.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <dynd/memblock/external_memory_block.hpp>
+
+#include "shared_memory_array.hpp"
+#include "array_functions.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+#if !defined(_WIN32)
+
+namespace {
+
+const char shared_magic[8] = {'D', 'Y', 'N', 'D', 'S', 'H', 'M', '1'};
+// The data is placed at a cache line boundary after the header
+const uint64_t shared_data_alignment = 64;
+
+/**
+ * The header at the start of a shared memory object,
+ * followed by the datashape string and then the data.
+ */
+struct shared_header {
+  char magic[8];
+  uint64_t type_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+/**
+ * One mapping of a shared memory object, owned by the external
+ * memory block which unmaps it on release.
+ */
+struct shared_mapping {
+  char *addr;
+  size_t size;
+  string name;
+};
+
+// The live mappings by address, to find the name of
+// a shared array. Releases can happen on any thread.
+mutex registry_mutex;
+map<const char *, shared_mapping *> registry;
+
+void release_shared_mapping(void *obj)
+{
+  shared_mapping *m = reinterpret_cast<shared_mapping *>(obj);
+  {
+    lock_guard<mutex> lock(registry_mutex);
+    registry.erase(m->addr);
+  }
+  munmap(m->addr, m->size);
+  delete m;
+}
+
+void throw_errno(const string &what, const string &name)
+{
+  stringstream ss;
+  ss << what << " shared memory \"" << name << "\": " << strerror(errno);
+  throw runtime_error(ss.str());
+}
+
+/**
+ * Closes a file descriptor at the end of the scope.
+ */
+class fd_closer {
+  int m_fd;
+
+public:
+  explicit fd_closer(int fd) : m_fd(fd) {}
+  ~fd_closer() { close(m_fd); }
+};
+
+/**
+ * Maps ``size`` bytes of the open shared memory object, and registers
+ * the mapping. The returned memory block owns the mapping.
+ */
+memory_block_ptr map_shared(int fd, const string &name, size_t size,
+                            bool writable, shared_mapping *&out)
+{
+  void *addr = mmap(NULL, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                    MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    throw_errno("could not map", name);
+  }
+  shared_mapping *m = new shared_mapping;
+  m->addr = reinterpret_cast<char *>(addr);
+  m->size = size;
+  m->name = name;
+  memory_block_ptr result;
+  try {
+    result = make_external_memory_block(m, &release_shared_mapping);
+  }
+  catch (...) {
+    munmap(addr, size);
+    delete m;
+    throw;
+  }
+  {
+    lock_guard<mutex> lock(registry_mutex);
+    registry[m->addr] = m;
+  }
+  out = m;
+  return result;
+}
+
+/**
+ * Creates an array with default arrmeta viewing ``data``, held
+ * alive by ``owner``.
+ */
+nd::array make_shared_view(const ndt::type &tp, char *data,
+                           const memory_block_ptr &owner,
+                           uint32_t access_flags)
+{
+  nd::array result(make_array_memory_block(tp.get_arrmeta_size()));
+  if (tp.get_arrmeta_size() > 0) {
+    tp.extended()->arrmeta_default_construct(result.get_arrmeta(), false);
+  }
+  result.get_ndo()->m_data_pointer = data;
+  result.get_ndo()->m_data_reference = owner.get();
+  memory_block_incref(owner.get());
+  ndt::type(tp).swap(result.get_ndo()->m_type);
+  result.get_ndo()->m_flags = access_flags;
+  return result;
+}
+
+string generate_shared_name()
+{
+  static unsigned counter = 0;
+  stringstream ss;
+  ss << "/dynd-" << getpid() << "-" << ++counter;
+  return ss.str();
+}
+
+} // anonymous namespace
+
+nd::array pydynd::array_shared_empty(const ndt::type &tp, PyObject *name)
+{
+  if (tp.is_symbolic()) {
+    stringstream ss;
+    ss << "Cannot create a dynd array with symbolic type " << tp;
+    throw type_error(ss.str());
+  }
+  if (!tp.is_builtin() &&
+      (tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0) {
+    stringstream ss;
+    ss << "Cannot place dynd type " << tp << " in shared memory, its data "
+                                            "references other memory blocks";
+    throw type_error(ss.str());
+  }
+
+  stringstream tp_ss;
+  tp_ss << tp;
+  string tp_str = tp_ss.str();
+  shared_header header;
+  memcpy(header.magic, shared_magic, sizeof(shared_magic));
+  header.type_size = tp_str.size();
+  header.data_offset = (sizeof(shared_header) + tp_str.size() +
+                        shared_data_alignment - 1) &
+                       ~(shared_data_alignment - 1);
+  header.data_size = tp.get_data_size();
+  size_t total_size = static_cast<size_t>(header.data_offset + header.data_size);
+
+  // Create the shared memory object, retrying generated names
+  // which happen to be taken
+  string name_str;
+  int fd;
+  do {
+    name_str = (name == Py_None) ? generate_shared_name()
+                                 : pystring_as_string(name);
+    fd = shm_open(name_str.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  } while (fd < 0 && errno == EEXIST && name == Py_None);
+  if (fd < 0) {
+    throw_errno("could not create", name_str);
+  }
+  fd_closer closer(fd);
+
+  shared_mapping *m = NULL;
+  memory_block_ptr owner;
+  try {
+    if (ftruncate(fd, total_size) < 0) {
+      throw_errno("could not size", name_str);
+    }
+    owner = map_shared(fd, name_str, total_size, true, m);
+  }
+  catch (...) {
+    shm_unlink(name_str.c_str());
+    throw;
+  }
+  memcpy(m->addr, &header, sizeof(header));
+  memcpy(m->addr + sizeof(header), tp_str.data(), tp_str.size());
+
+  return make_shared_view(tp, m->addr + header.data_offset, owner,
+                          nd::read_access_flag | nd::write_access_flag);
+}
+
+nd::array pydynd::array_from_shared(PyObject *name, PyObject *access)
+{
+  string name_str = pystring_as_string(name);
+  uint32_t access_flags = nd::read_access_flag;
+  if (access != Py_None) {
+    access_flags = pyarg_strings_to_int(
+        access, "access", 0, "readwrite",
+        nd::read_access_flag | nd::write_access_flag, "rw",
+        nd::read_access_flag | nd::write_access_flag, "readonly",
+        nd::read_access_flag, "r", nd::read_access_flag, "immutable",
+        nd::read_access_flag | nd::immutable_access_flag);
+  }
+  bool writable = (access_flags & nd::write_access_flag) != 0;
+
+  int fd = shm_open(name_str.c_str(), writable ? O_RDWR : O_RDONLY, 0);
+  if (fd < 0) {
+    throw_errno("could not open", name_str);
+  }
+  fd_closer closer(fd);
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    throw_errno("could not stat", name_str);
+  }
+  size_t total_size = static_cast<size_t>(st.st_size);
+  if (total_size < sizeof(shared_header)) {
+    stringstream ss;
+    ss << "shared memory \"" << name_str << "\" does not hold a dynd array";
+    throw runtime_error(ss.str());
+  }
+
+  shared_mapping *m = NULL;
+  memory_block_ptr owner = map_shared(fd, name_str, total_size, writable, m);
+  shared_header header;
+  memcpy(&header, m->addr, sizeof(header));
+  if (memcmp(header.magic, shared_magic, sizeof(shared_magic)) != 0 ||
+      sizeof(shared_header) + header.type_size > header.data_offset ||
+      header.data_offset + header.data_size > total_size) {
+    stringstream ss;
+    ss << "shared memory \"" << name_str << "\" does not hold a dynd array";
+    throw runtime_error(ss.str());
+  }
+  ndt::type tp(string(m->addr + sizeof(header),
+                      static_cast<size_t>(header.type_size)));
+  if (tp.get_data_size() != header.data_size) {
+    stringstream ss;
+    ss << "shared memory \"" << name_str << "\" has " << header.data_size
+       << " bytes of data, which does not match its dynd type " << tp;
+    throw runtime_error(ss.str());
+  }
+
+  return make_shared_view(tp, m->addr + header.data_offset, owner,
+                          access_flags);
+}
+
+PyObject *pydynd::array_shared_name(const nd::array &n)
+{
+  const char *data = n.get_ndo()->m_data_pointer;
+  lock_guard<mutex> lock(registry_mutex);
+  map<const char *, shared_mapping *>::const_iterator it =
+      registry.upper_bound(data);
+  if (it != registry.begin()) {
+    --it;
+    const shared_mapping *m = it->second;
+    if (data < m->addr + m->size) {
+      return pystring_from_string(m->name);
+    }
+  }
+  Py_RETURN_NONE;
+}
+
+void pydynd::shared_unlink(PyObject *name)
+{
+  string name_str = pystring_as_string(name);
+  if (shm_unlink(name_str.c_str()) < 0) {
+    throw_errno("could not unlink", name_str);
+  }
+}
+
+#else // defined(_WIN32)
+
+nd::array pydynd::array_shared_empty(const ndt::type &DYND_UNUSED(tp),
+                                     PyObject *DYND_UNUSED(name))
+{
+  throw runtime_error("dynd shared memory arrays require POSIX shm_open");
+}
+
+nd::array pydynd::array_from_shared(PyObject *DYND_UNUSED(name),
+                                    PyObject *DYND_UNUSED(access))
+{
+  throw runtime_error("dynd shared memory arrays require POSIX shm_open");
+}
+
+PyObject *pydynd::array_shared_name(const nd::array &DYND_UNUSED(n))
+{
+  Py_RETURN_NONE;
+}
+
+void pydynd::shared_unlink(PyObject *DYND_UNUSED(name))
+{
+  throw runtime_error("dynd shared memory arrays require POSIX shm_open");
+}
+
+#endif // defined(_WIN32)
@@ -0,0 +1,780 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <dynd/shape_tools.hpp>
+#include <dynd/type_promotion.hpp>
+#include <dynd/types/base_dim_type.hpp>
+
+#include "simd_arithmetic.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define PYDYND_SIMD_X86 1
+#include <immintrin.h>
+#define PYDYND_TARGET_SSE2 __attribute__((target("sse2")))
+#define PYDYND_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PYDYND_SIMD_X86 0
+#endif
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+namespace {
+
+typedef void (*binary_loop_t)(char *dst, const char *lhs, const char *rhs,
+                              size_t count);
+
+struct add_op {
+  template <typename T>
+  static inline T apply(T lhs, T rhs)
+  {
+    return lhs + rhs;
+  }
+};
+
+struct subtract_op {
+  template <typename T>
+  static inline T apply(T lhs, T rhs)
+  {
+    return lhs - rhs;
+  }
+};
+
+struct multiply_op {
+  template <typename T>
+  static inline T apply(T lhs, T rhs)
+  {
+    return lhs * rhs;
+  }
+};
+
+struct divide_op {
+  template <typename T>
+  static inline T apply(T lhs, T rhs)
+  {
+    return lhs / rhs;
+  }
+};
+
+/**
+ * The loops below are parameterized by the operand types L and R and
+ * compute in the promoted type T, converting each element as it is
+ * loaded, so mixed-type operations need no converted temporary. When
+ * LB (or RB) is set, the lhs (or rhs) is a 0-d operand that is
+ * converted once and broadcast across the other operand.
+ */
+template <typename T, typename Op, typename L, typename R, bool LB, bool RB>
+void scalar_loop(char *dst, const char *lhs, const char *rhs, size_t count)
+{
+  T *d = reinterpret_cast<T *>(dst);
+  const L *l = reinterpret_cast<const L *>(lhs);
+  const R *r = reinterpret_cast<const R *>(rhs);
+  const T ls = LB ? static_cast<T>(*l) : T();
+  const T rs = RB ? static_cast<T>(*r) : T();
+  for (size_t i = 0; i != count; ++i) {
+    d[i] = Op::apply(LB ? ls : static_cast<T>(l[i]),
+                     RB ? rs : static_cast<T>(r[i]));
+  }
+}
+
+#if PYDYND_SIMD_X86
+
+/**
+ * The vector loop body shared by the SSE2 and AVX2 variants. The
+ * destination is freshly allocated, so a scalar prologue brings it to
+ * vector alignment and the main loop uses aligned stores, while the
+ * sources, which may be arbitrary views, use unaligned loads.
+ */
+#define PYDYND_SIMD_LOOP_BODY(V, Op, L, R, LB, RB)                             \
+  typedef typename V::scalar T;                                                \
+  typedef typename V::vec vec;                                                 \
+  T *d = reinterpret_cast<T *>(dst);                                           \
+  const L *l = reinterpret_cast<const L *>(lhs);                               \
+  const R *r = reinterpret_cast<const R *>(rhs);                               \
+  const T ls = LB ? static_cast<T>(*l) : T();                                  \
+  const T rs = RB ? static_cast<T>(*r) : T();                                  \
+  const vec lv = V::set1(ls), rv = V::set1(rs);                                \
+  size_t i = 0;                                                                \
+  const uintptr_t align_mask = sizeof(vec) - 1;                                \
+  for (; i < count && (reinterpret_cast<uintptr_t>(d + i) & align_mask) != 0;  \
+       ++i) {                                                                  \
+    d[i] = Op::apply(LB ? ls : static_cast<T>(l[i]),                           \
+                     RB ? rs : static_cast<T>(r[i]));                          \
+  }                                                                            \
+  for (; i + 2 * V::width <= count; i += 2 * V::width) {                       \
+    vec a0 = LB ? lv : V::load(l + i), b0 = RB ? rv : V::load(r + i);          \
+    vec a1 = LB ? lv : V::load(l + i + V::width),                              \
+        b1 = RB ? rv : V::load(r + i + V::width);                              \
+    V::store(d + i, V::apply(Op(), a0, b0));                                   \
+    V::store(d + i + V::width, V::apply(Op(), a1, b1));                        \
+  }                                                                            \
+  for (; i + V::width <= count; i += V::width) {                               \
+    V::store(d + i, V::apply(Op(), LB ? lv : V::load(l + i),                   \
+                             RB ? rv : V::load(r + i)));                       \
+  }                                                                            \
+  for (; i < count; ++i) {                                                     \
+    d[i] = Op::apply(LB ? ls : static_cast<T>(l[i]),                           \
+                     RB ? rs : static_cast<T>(r[i]));                          \
+  }
+
+/**
+ * Vector traits for computing in type T. The ``load`` overloads define
+ * which source types can be widened in registers, and the ``apply``
+ * overloads which operations have a packed instruction. Anything
+ * missing falls back to the scalar loop.
+ */
+template <typename T>
+struct sse2_vec;
+
+template <>
+struct sse2_vec<double> {
+  typedef double scalar;
+  typedef __m128d vec;
+  enum { width = 2 };
+  PYDYND_TARGET_SSE2 static inline vec load(const double *p)
+  {
+    return _mm_loadu_pd(p);
+  }
+  PYDYND_TARGET_SSE2 static inline vec load(const float *p)
+  {
+    return _mm_cvtps_pd(_mm_castsi128_ps(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+  }
+  PYDYND_TARGET_SSE2 static inline vec load(const int32_t *p)
+  {
+    return _mm_cvtepi32_pd(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+  PYDYND_TARGET_SSE2 static inline vec set1(scalar v)
+  {
+    return _mm_set1_pd(v);
+  }
+  PYDYND_TARGET_SSE2 static inline void store(scalar *p, vec v)
+  {
+    _mm_store_pd(p, v);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm_add_pd(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm_sub_pd(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(multiply_op, vec a, vec b)
+  {
+    return _mm_mul_pd(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(divide_op, vec a, vec b)
+  {
+    return _mm_div_pd(a, b);
+  }
+};
+
+template <>
+struct sse2_vec<float> {
+  typedef float scalar;
+  typedef __m128 vec;
+  enum { width = 4 };
+  PYDYND_TARGET_SSE2 static inline vec load(const float *p)
+  {
+    return _mm_loadu_ps(p);
+  }
+  PYDYND_TARGET_SSE2 static inline vec load(const int32_t *p)
+  {
+    return _mm_cvtepi32_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  PYDYND_TARGET_SSE2 static inline vec set1(scalar v)
+  {
+    return _mm_set1_ps(v);
+  }
+  PYDYND_TARGET_SSE2 static inline void store(scalar *p, vec v)
+  {
+    _mm_store_ps(p, v);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm_add_ps(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm_sub_ps(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(multiply_op, vec a, vec b)
+  {
+    return _mm_mul_ps(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(divide_op, vec a, vec b)
+  {
+    return _mm_div_ps(a, b);
+  }
+};
+
+// SSE2 has no packed 32 or 64-bit integer multiply, so the
+// integer traits only provide addition and subtraction
+template <>
+struct sse2_vec<int32_t> {
+  typedef int32_t scalar;
+  typedef __m128i vec;
+  enum { width = 4 };
+  PYDYND_TARGET_SSE2 static inline vec load(const int32_t *p)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  PYDYND_TARGET_SSE2 static inline vec set1(scalar v)
+  {
+    return _mm_set1_epi32(v);
+  }
+  PYDYND_TARGET_SSE2 static inline void store(scalar *p, vec v)
+  {
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm_add_epi32(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm_sub_epi32(a, b);
+  }
+};
+
+template <>
+struct sse2_vec<int64_t> {
+  typedef int64_t scalar;
+  typedef __m128i vec;
+  enum { width = 2 };
+  PYDYND_TARGET_SSE2 static inline vec load(const int64_t *p)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  PYDYND_TARGET_SSE2 static inline vec load(const int32_t *p)
+  {
+    // Sign extend by interleaving with the sign bits
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+    return _mm_unpacklo_epi32(v, _mm_srai_epi32(v, 31));
+  }
+  PYDYND_TARGET_SSE2 static inline vec set1(scalar v)
+  {
+    return _mm_set1_epi64x(v);
+  }
+  PYDYND_TARGET_SSE2 static inline void store(scalar *p, vec v)
+  {
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), v);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm_add_epi64(a, b);
+  }
+  PYDYND_TARGET_SSE2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm_sub_epi64(a, b);
+  }
+};
+
+template <typename T>
+struct avx2_vec;
+
+template <>
+struct avx2_vec<double> {
+  typedef double scalar;
+  typedef __m256d vec;
+  enum { width = 4 };
+  PYDYND_TARGET_AVX2 static inline vec load(const double *p)
+  {
+    return _mm256_loadu_pd(p);
+  }
+  PYDYND_TARGET_AVX2 static inline vec load(const float *p)
+  {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+  }
+  PYDYND_TARGET_AVX2 static inline vec load(const int32_t *p)
+  {
+    return _mm256_cvtepi32_pd(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  PYDYND_TARGET_AVX2 static inline vec set1(scalar v)
+  {
+    return _mm256_set1_pd(v);
+  }
+  PYDYND_TARGET_AVX2 static inline void store(scalar *p, vec v)
+  {
+    _mm256_store_pd(p, v);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm256_add_pd(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm256_sub_pd(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(multiply_op, vec a, vec b)
+  {
+    return _mm256_mul_pd(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(divide_op, vec a, vec b)
+  {
+    return _mm256_div_pd(a, b);
+  }
+};
+
+template <>
+struct avx2_vec<float> {
+  typedef float scalar;
+  typedef __m256 vec;
+  enum { width = 8 };
+  PYDYND_TARGET_AVX2 static inline vec load(const float *p)
+  {
+    return _mm256_loadu_ps(p);
+  }
+  PYDYND_TARGET_AVX2 static inline vec load(const int32_t *p)
+  {
+    return _mm256_cvtepi32_ps(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+  }
+  PYDYND_TARGET_AVX2 static inline vec set1(scalar v)
+  {
+    return _mm256_set1_ps(v);
+  }
+  PYDYND_TARGET_AVX2 static inline void store(scalar *p, vec v)
+  {
+    _mm256_store_ps(p, v);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm256_add_ps(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm256_sub_ps(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(multiply_op, vec a, vec b)
+  {
+    return _mm256_mul_ps(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(divide_op, vec a, vec b)
+  {
+    return _mm256_div_ps(a, b);
+  }
+};
+
+// AVX2 has a packed 32-bit integer multiply, but no 64-bit one
+template <>
+struct avx2_vec<int32_t> {
+  typedef int32_t scalar;
+  typedef __m256i vec;
+  enum { width = 8 };
+  PYDYND_TARGET_AVX2 static inline vec load(const int32_t *p)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  PYDYND_TARGET_AVX2 static inline vec set1(scalar v)
+  {
+    return _mm256_set1_epi32(v);
+  }
+  PYDYND_TARGET_AVX2 static inline void store(scalar *p, vec v)
+  {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm256_add_epi32(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm256_sub_epi32(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(multiply_op, vec a, vec b)
+  {
+    return _mm256_mullo_epi32(a, b);
+  }
+};
+
+template <>
+struct avx2_vec<int64_t> {
+  typedef int64_t scalar;
+  typedef __m256i vec;
+  enum { width = 4 };
+  PYDYND_TARGET_AVX2 static inline vec load(const int64_t *p)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  PYDYND_TARGET_AVX2 static inline vec load(const int32_t *p)
+  {
+    return _mm256_cvtepi32_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  PYDYND_TARGET_AVX2 static inline vec set1(scalar v)
+  {
+    return _mm256_set1_epi64x(v);
+  }
+  PYDYND_TARGET_AVX2 static inline void store(scalar *p, vec v)
+  {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(add_op, vec a, vec b)
+  {
+    return _mm256_add_epi64(a, b);
+  }
+  PYDYND_TARGET_AVX2 static inline vec apply(subtract_op, vec a, vec b)
+  {
+    return _mm256_sub_epi64(a, b);
+  }
+};
+
+template <typename V, typename Op, typename L, typename R, bool LB, bool RB>
+PYDYND_TARGET_SSE2 void sse2_loop(char *dst, const char *lhs, const char *rhs,
+                                  size_t count)
+{
+  PYDYND_SIMD_LOOP_BODY(V, Op, L, R, LB, RB)
+}
+
+template <typename V, typename Op, typename L, typename R, bool LB, bool RB>
+PYDYND_TARGET_AVX2 void avx2_loop(char *dst, const char *lhs, const char *rhs,
+                                  size_t count)
+{
+  PYDYND_SIMD_LOOP_BODY(V, Op, L, R, LB, RB)
+}
+
+#undef PYDYND_SIMD_LOOP_BODY
+
+/**
+ * True if the vector traits V can load (and widen) elements of type X.
+ */
+template <typename V, typename X>
+struct can_load {
+  template <typename U>
+  static char test(decltype(U::load(static_cast<const X *>(NULL))) *);
+  template <typename U>
+  static long test(...);
+  static const bool value = sizeof(test<V>(NULL)) == 1;
+};
+
+/**
+ * True if the vector traits V have a packed instruction for Op.
+ */
+template <typename V, typename Op>
+struct can_apply {
+  template <typename U>
+  static char test(decltype(U::apply(Op(), declval<typename U::vec>(),
+                                     declval<typename U::vec>())) *);
+  template <typename U>
+  static long test(...);
+  static const bool value = sizeof(test<V>(NULL)) == 1;
+};
+
+template <typename V, typename Op, typename L, typename R>
+struct is_vectorizable
+    : integral_constant<bool, can_load<V, L>::value &&
+                                  can_load<V, R>::value &&
+                                  can_apply<V, Op>::value> {
+};
+
+template <typename T, typename Op, typename L, typename R, bool LB, bool RB>
+binary_loop_t select_sse2_loop(true_type)
+{
+  return &sse2_loop<sse2_vec<T>, Op, L, R, LB, RB>;
+}
+
+template <typename T, typename Op, typename L, typename R, bool LB, bool RB>
+binary_loop_t select_sse2_loop(false_type)
+{
+  return &scalar_loop<T, Op, L, R, LB, RB>;
+}
+
+template <typename T, typename Op, typename L, typename R, bool LB, bool RB>
+binary_loop_t select_avx2_loop(true_type)
+{
+  return &avx2_loop<avx2_vec<T>, Op, L, R, LB, RB>;
+}
+
+template <typename T, typename Op, typename L, typename R, bool LB, bool RB>
+binary_loop_t select_avx2_loop(false_type)
+{
+  return &scalar_loop<T, Op, L, R, LB, RB>;
+}
+
+#endif // PYDYND_SIMD_X86
+
+enum {
+  type_index_int32,
+  type_index_int64,
+  type_index_float32,
+  type_index_float64,
+  type_index_count
+};
+
+enum { broadcast_none, broadcast_lhs, broadcast_rhs, broadcast_count };
+
+template <typename T>
+struct type_id_of;
+
+template <>
+struct type_id_of<int32_t> {
+  static const type_id_t value = int32_type_id;
+};
+
+template <>
+struct type_id_of<int64_t> {
+  static const type_id_t value = int64_type_id;
+};
+
+template <>
+struct type_id_of<float> {
+  static const type_id_t value = float32_type_id;
+};
+
+template <>
+struct type_id_of<double> {
+  static const type_id_t value = float64_type_id;
+};
+
+/**
+ * The loop table, indexed by [simd level][lhs type][rhs type][op]
+ * [broadcast]. The result is computed in the C++ promoted type of the
+ * operands. Pairs for which this differs from the dynd arithmetic
+ * promotion have no entries, so their result type is always the one
+ * the general dynd kernels produce. Integer division has no entry
+ * either, it is left to the general dynd kernels so that division by
+ * zero is reported the same way as everywhere else.
+ */
+struct loop_table {
+  binary_loop_t loops[3][type_index_count][type_index_count][4]
+                     [broadcast_count];
+  type_id_t result_type_id[type_index_count][type_index_count];
+
+  loop_table()
+  {
+    fill_lhs<int32_t>(type_index_int32);
+    fill_lhs<int64_t>(type_index_int64);
+    fill_lhs<float>(type_index_float32);
+    fill_lhs<double>(type_index_float64);
+  }
+
+  template <typename L>
+  void fill_lhs(int li)
+  {
+    fill_pair<L, int32_t>(li, type_index_int32);
+    fill_pair<L, int64_t>(li, type_index_int64);
+    fill_pair<L, float>(li, type_index_float32);
+    fill_pair<L, double>(li, type_index_float64);
+  }
+
+  template <typename L, typename R>
+  void fill_pair(int li, int ri)
+  {
+    typedef decltype(L() + R()) T;
+    result_type_id[li][ri] = type_id_of<T>::value;
+    // For example int32 with float32 is float32 in C++, but not in dynd
+    type_id_t promoted_id =
+        promote_types_arithmetic(ndt::type(type_id_of<L>::value),
+                                 ndt::type(type_id_of<R>::value))
+            .get_type_id();
+    if (promoted_id != type_id_of<T>::value) {
+      for (int op = arithmetic_add; op <= arithmetic_divide; ++op) {
+        clear_op(li, ri, op);
+      }
+      return;
+    }
+    fill_op<add_op, L, R>(li, ri, arithmetic_add);
+    fill_op<subtract_op, L, R>(li, ri, arithmetic_subtract);
+    fill_op<multiply_op, L, R>(li, ri, arithmetic_multiply);
+    if (is_integral<T>::value) {
+      clear_op(li, ri, arithmetic_divide);
+    } else {
+      fill_op<divide_op, L, R>(li, ri, arithmetic_divide);
+    }
+  }
+
+  void clear_op(int li, int ri, int op)
+  {
+    for (int level = simd_level_scalar; level <= simd_level_avx2; ++level) {
+      for (int b = 0; b < broadcast_count; ++b) {
+        loops[level][li][ri][op][b] = NULL;
+      }
+    }
+  }
+
+  template <typename Op, typename L, typename R>
+  void fill_op(int li, int ri, int op)
+  {
+    fill_entry<Op, L, R, false, false>(li, ri, op, broadcast_none);
+    fill_entry<Op, L, R, true, false>(li, ri, op, broadcast_lhs);
+    fill_entry<Op, L, R, false, true>(li, ri, op, broadcast_rhs);
+  }
+
+  template <typename Op, typename L, typename R, bool LB, bool RB>
+  void fill_entry(int li, int ri, int op, int b)
+  {
+    typedef decltype(L() + R()) T;
+    loops[simd_level_scalar][li][ri][op][b] = &scalar_loop<T, Op, L, R, LB, RB>;
+#if PYDYND_SIMD_X86
+    loops[simd_level_sse2][li][ri][op][b] =
+        select_sse2_loop<T, Op, L, R, LB, RB>(
+            is_vectorizable<sse2_vec<T>, Op, L, R>());
+    loops[simd_level_avx2][li][ri][op][b] =
+        select_avx2_loop<T, Op, L, R, LB, RB>(
+            is_vectorizable<avx2_vec<T>, Op, L, R>());
+#else
+    loops[simd_level_sse2][li][ri][op][b] = &scalar_loop<T, Op, L, R, LB, RB>;
+    loops[simd_level_avx2][li][ri][op][b] = &scalar_loop<T, Op, L, R, LB, RB>;
+#endif
+  }
+};
+
+const loop_table &get_loop_table()
+{
+  static loop_table table;
+  return table;
+}
+
+int get_type_index(type_id_t tid)
+{
+  switch (tid) {
+  case int32_type_id:
+    return type_index_int32;
+  case int64_type_id:
+    return type_index_int64;
+  case float32_type_id:
+    return type_index_float32;
+  case float64_type_id:
+    return type_index_float64;
+  default:
+    return -1;
+  }
+}
+
+/**
+ * Returns the element type index of ``a`` if it is a C-contiguous array
+ * of fixed dimensions over one of the supported builtin types, and -1
+ * otherwise. The shape is returned in ``shape``.
+ */
+int get_contiguous_type_index(const nd::array &a, dimvector &shape)
+{
+  const ndt::type &tp = a.get_type();
+  intptr_t ndim = tp.get_ndim();
+  ndt::type el_tp = tp;
+  for (intptr_t i = 0; i < ndim; ++i) {
+    if (el_tp.get_type_id() != fixed_dim_type_id) {
+      return -1;
+    }
+    el_tp = el_tp.extended<ndt::base_dim_type>()->get_element_type();
+  }
+  int type_index = get_type_index(el_tp.get_type_id());
+  if (type_index < 0) {
+    return -1;
+  }
+
+  dimvector strides(ndim);
+  shape.init(ndim);
+  a.get_shape(shape.get());
+  a.get_strides(strides.get());
+  if (!strides_are_c_contiguous(ndim, el_tp.get_data_size(), shape.get(),
+                                strides.get())) {
+    return -1;
+  }
+  return type_index;
+}
+
+} // anonymous namespace
+
+simd_level_t pydynd::get_simd_level()
+{
+#if PYDYND_SIMD_X86
+  static const simd_level_t level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return simd_level_avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+      return simd_level_sse2;
+    } else {
+      return simd_level_scalar;
+    }
+  }();
+  return level;
+#else
+  return simd_level_scalar;
+#endif
+}
+
+const char *pydynd::get_simd_level_name()
+{
+  switch (get_simd_level()) {
+  case simd_level_avx2:
+    return "avx2";
+  case simd_level_sse2:
+    return "sse2";
+  default:
+    return "scalar";
+  }
+}
+
+bool pydynd::simd_binary_arithmetic(arithmetic_op_t op, const nd::array &lhs,
+                                    const nd::array &rhs, nd::array &out)
+{
+  if (lhs.is_null() || rhs.is_null()) {
+    return false;
+  }
+
+  dimvector lhs_shape, rhs_shape;
+  int li = get_contiguous_type_index(lhs, lhs_shape);
+  if (li < 0) {
+    return false;
+  }
+  int ri = get_contiguous_type_index(rhs, rhs_shape);
+  if (ri < 0) {
+    return false;
+  }
+
+  // Either the shapes match exactly, or one side is a 0-d scalar
+  intptr_t lhs_ndim = lhs.get_ndim(), rhs_ndim = rhs.get_ndim();
+  int broadcast;
+  intptr_t ndim;
+  const intptr_t *shape;
+  if (lhs_ndim == rhs_ndim &&
+      equal(lhs_shape.get(), lhs_shape.get() + lhs_ndim, rhs_shape.get())) {
+    broadcast = broadcast_none;
+    ndim = lhs_ndim;
+    shape = lhs_shape.get();
+  } else if (lhs_ndim == 0) {
+    broadcast = broadcast_lhs;
+    ndim = rhs_ndim;
+    shape = rhs_shape.get();
+  } else if (rhs_ndim == 0) {
+    broadcast = broadcast_rhs;
+    ndim = lhs_ndim;
+    shape = lhs_shape.get();
+  } else {
+    return false;
+  }
+
+  const loop_table &table = get_loop_table();
+  binary_loop_t loop = table.loops[get_simd_level()][li][ri][op][broadcast];
+  if (loop == NULL) {
+    return false;
+  }
+
+  intptr_t count = 1;
+  for (intptr_t i = 0; i < ndim; ++i) {
+    count *= shape[i];
+  }
+  ndt::type result_tp = ndt::type(table.result_type_id[li][ri]);
+  if (ndim > 0) {
+    result_tp = ndt::make_fixed_dim(ndim, shape, result_tp);
+  }
+  nd::array result = nd::empty(result_tp);
+  loop(result.get_readwrite_originptr(), lhs.get_readonly_originptr(),
+       rhs.get_readonly_originptr(), static_cast<size_t>(count));
+  out = result;
+  return true;
+}
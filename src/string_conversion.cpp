@@ -0,0 +1,45 @@
+//
+// Copyright (C) 2011-15 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <Python.h>
+
+#include "string_conversion.hpp"
+
+using namespace std;
+using namespace dynd;
+using namespace pydynd;
+
+PYDYND_THREAD_LOCAL pystring_dedupe_table *pystring_dedupe_table::s_current =
+    NULL;
+
+pystring_dedupe_table::~pystring_dedupe_table()
+{
+  for (unordered_map<string, PyObject *>::iterator it = m_strings.begin();
+       it != m_strings.end(); ++it) {
+    Py_DECREF(it->second);
+  }
+}
+
+PyObject *pystring_dedupe_table::get(string_encoding_t encoding,
+                                     const char *begin, const char *end,
+                                     PyObject *(*decode)(const char *,
+                                                         const char *))
+{
+  // The same bytes decode differently in different encodings
+  m_key.assign(1, static_cast<char>(encoding));
+  m_key.append(begin, end);
+  unordered_map<string, PyObject *>::const_iterator it = m_strings.find(m_key);
+  if (it != m_strings.end()) {
+    Py_INCREF(it->second);
+    return it->second;
+  }
+
+  PyObject *result = decode(begin, end);
+  if (result != NULL && m_strings.size() < max_size) {
+    m_strings[m_key] = result;
+    Py_INCREF(result);
+  }
+  return result;
+}